@@ -0,0 +1,215 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <bit>
+#include "Color.h"
+
+// Compiler avec USE_PEXT (ou /arch:AVX2 / -mbmi2) pour indexer les tables avec PEXT (BMI2)
+#if defined(__BMI2__) && !defined(USE_PEXT)
+#define USE_PEXT
+#endif
+
+#ifdef USE_PEXT
+#include <immintrin.h>
+#endif
+
+// Un bitboard = 64 bits, un bit par case.
+// Numérotation des cases: a1 = 0, b1 = 1, ..., h8 = 63.
+// Le GUI utilise (row, col) avec row 0 = 8e rangée (côté noir): voir squareAt/rowOf/colOf.
+using Bitboard = uint64_t;
+
+constexpr int SQUARE_COUNT = 64;
+constexpr int NO_SQUARE = 64;
+
+constexpr Bitboard FILE_A_BB = 0x0101010101010101ULL;
+constexpr Bitboard FILE_H_BB = FILE_A_BB << 7;
+constexpr Bitboard RANK_1_BB = 0xFFULL;
+constexpr Bitboard RANK_2_BB = RANK_1_BB << 8;
+constexpr Bitboard RANK_7_BB = RANK_1_BB << 48;
+constexpr Bitboard RANK_8_BB = RANK_1_BB << 56;
+
+constexpr int squareAt(int row, int col) { return (7 - row) * 8 + col; }
+constexpr int rowOf(int square) { return 7 - (square >> 3); }
+constexpr int colOf(int square) { return square & 7; }
+constexpr int rankOf(int square) { return square >> 3; }
+constexpr int fileOf(int square) { return square & 7; }
+
+constexpr Bitboard squareBB(int square) { return 1ULL << square; }
+
+inline int popCount(Bitboard b) { return std::popcount(b); }
+inline int lsb(Bitboard b) { return std::countr_zero(b); }
+inline int msb(Bitboard b) { return 63 - std::countl_zero(b); }
+
+// Retire et renvoie la case du bit de poids faible
+inline int popLsb(Bitboard& b) {
+    int square = lsb(b);
+    b &= b - 1;
+    return square;
+}
+
+constexpr bool moreThanOne(Bitboard b) { return (b & (b - 1)) != 0; }
+
+namespace Bitboards {
+    // Initialise les tables magic des pièces glissantes (appelée automatiquement au démarrage)
+    void init();
+
+    using SquareTable = std::array<Bitboard, SQUARE_COUNT>;
+    using SquarePairTable = std::array<SquareTable, SQUARE_COUNT>;
+
+    // Générateurs constexpr: les tables de géométrie et d'attaques des pièces sauteuses
+    // sont calculées par le compilateur et placées en lecture seule (aucun coût au démarrage)
+    namespace detail {
+        constexpr int KnightSteps[8][2] = {
+            {2, 1}, {2, -1}, {-2, 1}, {-2, -1}, {1, 2}, {1, -2}, {-1, 2}, {-1, -2}
+        };
+        constexpr int KingSteps[8][2] = {
+            {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}
+        };
+        constexpr int PawnSteps[COLOR_COUNT][2][2] = {
+            { {1, -1}, {1, 1} },    // Blancs
+            { {-1, -1}, {-1, 1} }   // Noirs
+        };
+        // Directions par paires opposées (2k, 2k + 1): rangée, colonne, deux diagonales
+        constexpr int RayDirections[8][2] = {
+            {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, -1}, {1, -1}, {-1, 1}
+        };
+
+        constexpr bool isOnBoard(int rank, int file) {
+            return rank >= 0 && rank < 8 && file >= 0 && file < 8;
+        }
+
+        template <int N>
+        constexpr Bitboard stepAttacks(int square, const int (&steps)[N][2]) {
+            Bitboard attacks = 0;
+            for (int i = 0; i < N; i++) {
+                int rank = rankOf(square) + steps[i][0];
+                int file = fileOf(square) + steps[i][1];
+                if (isOnBoard(rank, file)) attacks |= squareBB(rank * 8 + file);
+            }
+            return attacks;
+        }
+
+        template <int N>
+        constexpr SquareTable makeStepTable(const int (&steps)[N][2]) {
+            SquareTable table{};
+            for (int square = 0; square < SQUARE_COUNT; square++) {
+                table[square] = stepAttacks(square, steps);
+            }
+            return table;
+        }
+
+        // Cases depuis square (exclue) jusqu'au bord dans une direction, plateau vide
+        constexpr Bitboard ray(int square, const int (&direction)[2]) {
+            Bitboard result = 0;
+            int rank = rankOf(square) + direction[0];
+            int file = fileOf(square) + direction[1];
+            while (isOnBoard(rank, file)) {
+                result |= squareBB(rank * 8 + file);
+                rank += direction[0];
+                file += direction[1];
+            }
+            return result;
+        }
+
+        constexpr SquarePairTable makeBetweenTable() {
+            SquarePairTable table{};
+            for (int square = 0; square < SQUARE_COUNT; square++) {
+                for (const auto& direction : RayDirections) {
+                    Bitboard path = 0;
+                    int rank = rankOf(square) + direction[0];
+                    int file = fileOf(square) + direction[1];
+                    while (isOnBoard(rank, file)) {
+                        int target = rank * 8 + file;
+                        table[square][target] = path;
+                        path |= squareBB(target);
+                        rank += direction[0];
+                        file += direction[1];
+                    }
+                }
+            }
+            return table;
+        }
+
+        constexpr SquarePairTable makeLineTable() {
+            SquarePairTable table{};
+            for (int square = 0; square < SQUARE_COUNT; square++) {
+                for (int axis = 0; axis < 4; axis++) {
+                    Bitboard line = squareBB(square)
+                                  | ray(square, RayDirections[2 * axis])
+                                  | ray(square, RayDirections[2 * axis + 1]);
+                    for (int target = 0; target < SQUARE_COUNT; target++) {
+                        if (target != square && (line & squareBB(target))) table[square][target] = line;
+                    }
+                }
+            }
+            return table;
+        }
+
+        constexpr std::array<std::array<uint8_t, SQUARE_COUNT>, SQUARE_COUNT> makeDistanceTable() {
+            std::array<std::array<uint8_t, SQUARE_COUNT>, SQUARE_COUNT> table{};
+            for (int a = 0; a < SQUARE_COUNT; a++) {
+                for (int b = 0; b < SQUARE_COUNT; b++) {
+                    int rankDistance = rankOf(a) > rankOf(b) ? rankOf(a) - rankOf(b) : rankOf(b) - rankOf(a);
+                    int fileDistance = fileOf(a) > fileOf(b) ? fileOf(a) - fileOf(b) : fileOf(b) - fileOf(a);
+                    table[a][b] = static_cast<uint8_t>(rankDistance > fileDistance ? rankDistance : fileDistance);
+                }
+            }
+            return table;
+        }
+    }
+
+    inline constexpr std::array<SquareTable, COLOR_COUNT> PawnAttacks = {
+        detail::makeStepTable(detail::PawnSteps[0]), detail::makeStepTable(detail::PawnSteps[1])
+    };
+    inline constexpr SquareTable KnightAttacks = detail::makeStepTable(detail::KnightSteps);
+    inline constexpr SquareTable KingAttacks = detail::makeStepTable(detail::KingSteps);
+
+    // Cases strictement entre deux cases alignées / ligne complète passant par les deux (0 sinon)
+    inline constexpr SquarePairTable BetweenBB = detail::makeBetweenTable();
+    inline constexpr SquarePairTable LineBB = detail::makeLineTable();
+
+    // Distance de Chebyshev (nombre de pas de roi) entre deux cases
+    inline constexpr std::array<std::array<uint8_t, SQUARE_COUNT>, SQUARE_COUNT> SquareDistance =
+        detail::makeDistanceTable();
+
+    constexpr Bitboard pawnAttacks(Color color, int square) { return PawnAttacks[toIndex(color)][square]; }
+    constexpr Bitboard knightAttacks(int square) { return KnightAttacks[square]; }
+    constexpr Bitboard kingAttacks(int square) { return KingAttacks[square]; }
+    constexpr Bitboard between(int a, int b) { return BetweenBB[a][b]; }
+    constexpr Bitboard line(int a, int b) { return LineBB[a][b]; }
+    constexpr int distance(int a, int b) { return SquareDistance[a][b]; }
+
+    // Entrée magic d'une case: les bits de l'occupation pertinents pour la pièce glissante
+    // sont ramenés à un index dans la table d'attaques (multiplication + décalage, ou PEXT)
+    struct Magic {
+        Bitboard mask;
+        Bitboard magic;
+        Bitboard* attacks;
+        unsigned shift;
+
+        unsigned index(Bitboard occupied) const {
+#ifdef USE_PEXT
+            return static_cast<unsigned>(_pext_u64(occupied, mask));
+#else
+            return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+#endif
+        }
+    };
+
+    extern Magic RookMagics[SQUARE_COUNT];
+    extern Magic BishopMagics[SQUARE_COUNT];
+
+    // Attaques des pièces glissantes selon l'occupation: une seule consultation de table
+    inline Bitboard bishopAttacks(int square, Bitboard occupied) {
+        const Magic& m = BishopMagics[square];
+        return m.attacks[m.index(occupied)];
+    }
+    inline Bitboard rookAttacks(int square, Bitboard occupied) {
+        const Magic& m = RookMagics[square];
+        return m.attacks[m.index(occupied)];
+    }
+    inline Bitboard queenAttacks(int square, Bitboard occupied) {
+        return bishopAttacks(square, occupied) | rookAttacks(square, occupied);
+    }
+}
@@ -2,11 +2,14 @@
 
 #include <SFML/Graphics.hpp>
 #include <string>
-#include <stack>
+#include <vector>
 #include <utility>
 #include "ChessPiece.h"
 #include <filesystem>
 #include "Move.h"
+#include "Position.h"
+#include "GameRecord.h"
+#include "PieceView.h"
 #include "BoardTheme.h"
 #include "PieceSetType.h"  // Add this include
 #include <optional>  // Add for std::optional
@@ -23,18 +26,17 @@ struct LastMove {
 class ChessBoard {
 private:
     sf::RectangleShape boardSquares[8][8];
-    ChessPiece* pieces[8][8];
+    ChessPiece* pieces[8][8];  // Pièces du GUI, synchronisées avec la position de game
+    PieceView pieceViews[8][8];  // Sprites correspondants (couche d'affichage)
     sf::Texture pieceTextures[12];
     bool texturesLoaded;
     float squareSize;
     float boardX, boardY;
-    std::stack<Move> moveHistory;
     ThemeColors currentTheme;
     PieceSetType currentPieceSet;  // Add this member variable
 
-    // Tracking pour les règles de fin de partie
-    int halfMoveClock;  // Pour la règle des 50 coups
-    std::vector<std::string> positionHistory;  // Pour la triple répétition
+    // État de jeu de référence (bitboards, annulation, répétitions), sans SFML
+    GameRecord game;
     
     // King danger tracking
     std::pair<int, int> whiteKingDangerPos;  // Position du roi blanc en danger (-1, -1 si pas en danger)
@@ -45,18 +47,13 @@ private:
 
     bool createBlackPieceFromWhite(sf::Texture& blackTexture, const std::string& whitePieceName);
     void setupPiece(int row, int col, const std::string& type, const std::string& color);
+    void createPiece(int row, int col, const std::string& type, const std::string& color);
+    void syncPiecesFromPosition();
+    void updatePieceView(int row, int col);
     
     // New method to load themed pieces
     bool loadThemedPiece(sf::Texture& texture, const std::string& pieceName, const std::string& color, const BoardTheme& theme);
 
-    // Integrated move validation methods from extracted logic
-    bool isValidPawnMove(int fromRow, int fromCol, int toRow, int toCol, const std::string& color);
-    bool isValidRookMove(int fromRow, int fromCol, int toRow, int toCol);
-    bool isValidKnightMove(int fromRow, int fromCol, int toRow, int toCol);
-    bool isValidBishopMove(int fromRow, int fromCol, int toRow, int toCol);
-    bool isValidQueenMove(int fromRow, int fromCol, int toRow, int toCol);
-    bool isValidKingMove(int fromRow, int fromCol, int toRow, int toCol);
-
 public:
     ChessBoard();
     ~ChessBoard();
@@ -76,14 +73,16 @@ public:
     // Non-const and const accessors
     ChessPiece* getPieceAt(int row, int col);
     const ChessPiece* getPieceAt(int row, int col) const;
+    const Position& getPosition() const { return game.position(); }
+    const GameRecord& getGameRecord() const { return game; }
 
     bool movePiece(int fromRow, int fromCol, int toRow, int toCol);
-    bool movePiece(int fromRow, int fromCol, int toRow, int toCol, const std::string& promotionPiece);
+    bool movePiece(int fromRow, int fromCol, int toRow, int toCol, PieceType promotionPiece);
     bool undoMove();
     bool isValidMove(int fromRow, int fromCol, int toRow, int toCol);
     
     // Pawn promotion
-    void promotePawn(int row, int col, const std::string& promotionPiece);
+    void promotePawn(int row, int col, PieceType promotionPiece);
 
     sf::FloatRect getBounds() const;
     sf::Vector2f getSquarePosition(int row, int col) const;
@@ -91,7 +90,7 @@ public:
 
     // Helpers used by SaveLoadManager
     void removePiece(int row, int col);
-    void setPieceByNames(int row, int col, const std::string& type, const std::string& color);
+    void setPiece(int row, int col, PieceType type, Color color);
     
     // Reset board to initial state
     void reset();
@@ -99,18 +98,17 @@ public:
     bool isInsideBoard(int row, int col) const;
 
     // Méthodes pour la gestion des fins de partie
-    int getHalfMoveClock() const { return halfMoveClock; }
-    void resetHalfMoveClock() { halfMoveClock = 0; }
-    const std::vector<std::string>& getPositionHistory() const { return positionHistory; }
-    void recordCurrentPosition();
-    std::string generatePositionHash() const;
+    int getHalfMoveClock() const { return game.halfMoveClock(); }
+    void resetHalfMoveClock() { game.resetHalfMoveClock(); }
+    const std::vector<uint64_t>& getPositionHistory() const { return game.keyHistory(); }
+    int getRepetitionCount() const { return game.repetitionCount(); }
     
     // King danger detection and visual alert
-    std::pair<int, int> getKingPosition(const std::string& color) const;
-    bool isKingInDanger(const std::string& color) const;
+    std::pair<int, int> getKingPosition(Color color) const;
+    bool isKingInDanger(Color color) const;
     std::pair<int, int> getWhiteKingDangerPos() const { return whiteKingDangerPos; }
     std::pair<int, int> getBlackKingDangerPos() const { return blackKingDangerPos; }
-    void updateKingDangerStatus(const std::string& color, const class MoveValidator* validator);
+    void updateKingDangerStatus(Color color, const class MoveValidator* validator);
     void clearKingDangerStatus();
     void highlightKingDanger(sf::RenderWindow& window);
 
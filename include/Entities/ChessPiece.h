@@ -1,10 +1,10 @@
 #pragma once
-#include <SFML/Graphics.hpp>
 #include <string>
 #include "Move.h"
 
+// Pièce telle que vue par le GUI et la persistance. Aucun état de rendu ici:
+// le sprite correspondant est tenu par PieceView (couche d'affichage).
 struct ChessPiece {
-    sf::Sprite sprite;
     std::string type;
     std::string color;
     bool hasMoved;
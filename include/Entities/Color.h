@@ -3,6 +3,22 @@
 #ifndef COLOR_H
 #define COLOR_H
 
+#include <string>
+
 enum class Color { White, Black, None };
 
+constexpr int COLOR_COUNT = 2;
+
+constexpr int toIndex(Color color) {
+    return static_cast<int>(color);
+}
+
+constexpr Color opposite(Color color) {
+    return color == Color::White ? Color::Black : Color::White;
+}
+
+// Conversion avec les noms utilisés par le GUI ("white" / "black")
+std::string toString(Color color);
+Color colorFromString(const std::string& name);
+
 #endif // COLOR_H
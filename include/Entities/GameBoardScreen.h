@@ -43,6 +43,9 @@ private:
     // AI status display
     sf::Text aiStatusText;
     
+    // Analysis display (MultiPV, toggled with the A key)
+    sf::Text analysisText;
+    
     // Game end display
     sf::Text gameEndText;
     sf::RectangleShape gameEndOverlay;
@@ -71,6 +74,7 @@ private:
     void updateTurnIndicator();
     void updateScoreDisplay();
     void updateAIStatus();
+    void updateAnalysisDisplay();
     void updateBoardScale(sf::RenderWindow& window);
     void drawGameEndOverlay(sf::RenderWindow& window);
     void saveGameToDatabase();
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <stack>
+#include <vector>
+#include "Position.h"
+#include "PackedMove.h"
+
+/**
+ * @brief Déroulement d'une partie, sans aucune dépendance graphique
+ *
+ * Regroupe la position de référence, les positions précédentes (annulation)
+ * et les clés Zobrist des positions jouées (triple répétition).
+ * ChessBoard s'en sert pour l'affichage; l'IA, les outils et un éventuel
+ * serveur peuvent l'utiliser seuls.
+ */
+class GameRecord {
+public:
+    GameRecord();
+
+    // Repartir d'une position (position initiale par défaut), historique vidé
+    void reset(const Position& start = Position::startingPosition());
+
+    const Position& position() const { return m_position; }
+
+    // Jouer un coup légal et enregistrer la nouvelle position
+    void playMove(PackedMove move);
+    bool undoMove();
+
+    // Promotion choisie après coup par le GUI: remplace le pion de square
+    void promote(int square, PieceType type);
+
+    // Édition du plateau (chargement de partie): la clé enregistrée suit la position
+    void putPiece(Piece piece, int square);
+    void removePiece(int square);
+
+    int halfMoveClock() const { return m_position.halfMoveClock(); }
+    void resetHalfMoveClock() { m_position.setHalfMoveClock(0); }
+
+    // Occurrences de la position courante depuis le dernier coup irréversible
+    int repetitionCount() const;
+    const std::vector<uint64_t>& keyHistory() const { return m_keyHistory; }
+
+private:
+    Position m_position;
+    std::stack<Position> m_undoHistory;  // Position avant chaque coup
+    std::vector<uint64_t> m_keyHistory;  // Clé de chaque position jouée, la courante en dernier
+
+    void refreshCurrentKey();
+};
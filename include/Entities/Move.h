@@ -1,6 +1,6 @@
 #pragma once
 
-#include <string>
+#include "PieceType.h"
 
 enum class SpecialMoveType {
     None,
@@ -11,14 +11,16 @@ enum class SpecialMoveType {
 
 struct Move {
     int fromRow, fromCol, toRow, toCol;
-    std::string capturedType;
-    std::string capturedColor;
+    PieceType capturedType;      // PieceType::None si pas de prise
+    Color capturedColor;
     bool wasFirstMove;
     SpecialMoveType specialMove;
-    std::string promotionPiece; // For pawn promotion: "queen", "rook", "bishop", "knight"
+    PieceType promotionPiece;    // Pour la promotion: Queen, Rook, Bishop ou Knight
     
-    Move(int fr, int fc, int tr, int tc, const std::string& ct = "",
-         const std::string& cc = "", bool firstMove = false, 
+    Move(int fr, int fc, int tr, int tc, PieceType ct = PieceType::None,
+         Color cc = Color::None, bool firstMove = false, 
          SpecialMoveType special = SpecialMoveType::None,
-         const std::string& promotion = "");
+         PieceType promotion = PieceType::None);
+
+    bool isCapture() const { return capturedType != PieceType::None; }
 };
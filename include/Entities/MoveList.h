@@ -0,0 +1,41 @@
+#pragma once
+
+#include "PackedMove.h"
+
+// Aucune position légale n'a plus de 218 coups
+constexpr int MAX_MOVES = 256;
+
+/**
+ * @brief Liste de coups de capacité fixe, allouée sur la pile
+ *
+ * Remplie par MoveGenerator sans aucune allocation dynamique.
+ */
+class MoveList {
+public:
+    MoveList() : m_size(0) {}
+
+    void add(PackedMove move) { m_moves[m_size++] = move; }
+    void clear() { m_size = 0; }
+
+    int size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    PackedMove& operator[](int index) { return m_moves[index]; }
+    const PackedMove& operator[](int index) const { return m_moves[index]; }
+
+    PackedMove* begin() { return m_moves; }
+    PackedMove* end() { return m_moves + m_size; }
+    const PackedMove* begin() const { return m_moves; }
+    const PackedMove* end() const { return m_moves + m_size; }
+
+    bool contains(PackedMove move) const {
+        for (int i = 0; i < m_size; i++) {
+            if (m_moves[i] == move) return true;
+        }
+        return false;
+    }
+
+private:
+    PackedMove m_moves[MAX_MOVES];
+    int m_size;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "PieceType.h"
+
+class Position;
+struct Move;
+
+// Type de coup, stocké dans les 2 bits de poids fort
+enum MoveFlag : uint16_t {
+    NORMAL_MOVE = 0,
+    PROMOTION_MOVE = 1 << 14,
+    EN_PASSANT_MOVE = 2 << 14,
+    CASTLING_MOVE = 3 << 14
+};
+
+/**
+ * @brief Coup codé sur 16 bits pour la génération et la recherche
+ *
+ * bits 0-5: case de départ, bits 6-11: case d'arrivée,
+ * bits 12-13: pièce de promotion (cavalier..dame), bits 14-15: MoveFlag.
+ * Le roque est codé roi -> case d'arrivée du roi (e1g1, e1c1...).
+ * La valeur 0 (a1a1) sert de coup nul.
+ */
+class PackedMove {
+public:
+    constexpr PackedMove() : m_data(0) {}
+    constexpr explicit PackedMove(uint16_t data) : m_data(data) {}
+    constexpr PackedMove(int from, int to, MoveFlag flag = NORMAL_MOVE,
+                         PieceType promotion = PieceType::Knight)
+        : m_data(static_cast<uint16_t>(from | (to << 6) | flag
+                 | ((toIndex(promotion) - toIndex(PieceType::Knight)) << 12))) {}
+
+    constexpr int from() const { return m_data & 0x3F; }
+    constexpr int to() const { return (m_data >> 6) & 0x3F; }
+    constexpr MoveFlag flag() const { return static_cast<MoveFlag>(m_data & (3 << 14)); }
+    constexpr bool isPromotion() const { return flag() == PROMOTION_MOVE; }
+    constexpr PieceType promotionType() const {
+        return isPromotion() ? static_cast<PieceType>(((m_data >> 12) & 3) + toIndex(PieceType::Knight))
+                             : PieceType::None;
+    }
+
+    constexpr uint16_t raw() const { return m_data; }
+    constexpr bool isNull() const { return m_data == 0; }
+    constexpr explicit operator bool() const { return m_data != 0; }
+
+    constexpr bool operator==(const PackedMove& other) const { return m_data == other.m_data; }
+    constexpr bool operator!=(const PackedMove& other) const { return m_data != other.m_data; }
+
+private:
+    uint16_t m_data;
+};
+
+// Notation UCI ("e2e4", "e7e8q"), utilisée par les outils et les logs de l'IA
+std::string toUciString(PackedMove move);
+
+// Adaptateurs avec l'ancienne structure Move (GUI, SaveLoadManager, AI).
+// La position est celle d'avant le coup: elle fournit la pièce capturée et les coups spéciaux.
+Move toLegacyMove(PackedMove move, const Position& position);
+PackedMove toPackedMove(const Move& move, const Position& position);
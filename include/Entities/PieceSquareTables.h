@@ -0,0 +1,149 @@
+#pragma once
+
+#include <array>
+#include "Bitboard.h"
+#include "Color.h"
+#include "PieceType.h"
+
+// Tables pièce-case de l'évaluation, en centipions, construites à la compilation.
+// Chaque entrée contient la valeur matérielle plus le bonus de la case, pour le
+// milieu de partie (mg) et la finale (eg). Les pièces noires sont comptées en
+// négatif: la somme sur l'échiquier est le score du point de vue des blancs,
+// que Position tient à jour à chaque pose/retrait de pièce.
+namespace PieceSquare {
+
+    struct Score {
+        int mg = 0;
+        int eg = 0;
+
+        constexpr Score& operator+=(Score other) { mg += other.mg; eg += other.eg; return *this; }
+        constexpr Score& operator-=(Score other) { mg -= other.mg; eg -= other.eg; return *this; }
+        constexpr Score operator-() const { return { -mg, -eg }; }
+    };
+
+    // Phase de jeu: 24 avec toutes les pièces, 0 quand il ne reste que rois et pions
+    constexpr int PHASE_WEIGHTS[PIECE_TYPE_COUNT] = { 0, 1, 1, 2, 4, 0 };
+    constexpr int MAX_PHASE = 24;
+
+    constexpr Score MATERIAL[PIECE_TYPE_COUNT] = {
+        { 100, 120 },   // Pawn
+        { 320, 300 },   // Knight
+        { 330, 320 },   // Bishop
+        { 500, 530 },   // Rook
+        { 900, 940 },   // Queen
+        { 0, 0 }        // King
+    };
+
+    namespace detail {
+        using Table = std::array<int, SQUARE_COUNT>;
+
+        // Tables écrites comme un diagramme vu des blancs: 8e rangée en haut (index 0 = a8)
+        constexpr Table PawnMg = {
+              0,   0,   0,   0,   0,   0,   0,   0,
+             50,  50,  50,  50,  50,  50,  50,  50,
+             10,  10,  20,  30,  30,  20,  10,  10,
+              5,   5,  10,  25,  25,  10,   5,   5,
+              0,   0,   0,  20,  20,   0,   0,   0,
+              5,  -5, -10,   0,   0, -10,  -5,   5,
+              5,  10,  10, -20, -20,  10,  10,   5,
+              0,   0,   0,   0,   0,   0,   0,   0
+        };
+        constexpr Table PawnEg = {
+              0,   0,   0,   0,   0,   0,   0,   0,
+             80,  80,  80,  80,  80,  80,  80,  80,
+             50,  50,  50,  50,  50,  50,  50,  50,
+             30,  30,  30,  30,  30,  30,  30,  30,
+             15,  15,  15,  15,  15,  15,  15,  15,
+              5,   5,   5,   5,   5,   5,   5,   5,
+              0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0
+        };
+        constexpr Table Knight = {
+            -50, -40, -30, -30, -30, -30, -40, -50,
+            -40, -20,   0,   0,   0,   0, -20, -40,
+            -30,   0,  10,  15,  15,  10,   0, -30,
+            -30,   5,  15,  20,  20,  15,   5, -30,
+            -30,   0,  15,  20,  20,  15,   0, -30,
+            -30,   5,  10,  15,  15,  10,   5, -30,
+            -40, -20,   0,   5,   5,   0, -20, -40,
+            -50, -40, -30, -30, -30, -30, -40, -50
+        };
+        constexpr Table Bishop = {
+            -20, -10, -10, -10, -10, -10, -10, -20,
+            -10,   0,   0,   0,   0,   0,   0, -10,
+            -10,   0,   5,  10,  10,   5,   0, -10,
+            -10,   5,   5,  10,  10,   5,   5, -10,
+            -10,   0,  10,  10,  10,  10,   0, -10,
+            -10,  10,  10,  10,  10,  10,  10, -10,
+            -10,   5,   0,   0,   0,   0,   5, -10,
+            -20, -10, -10, -10, -10, -10, -10, -20
+        };
+        constexpr Table Rook = {
+              0,   0,   0,   0,   0,   0,   0,   0,
+              5,  10,  10,  10,  10,  10,  10,   5,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+              0,   0,   0,   5,   5,   0,   0,   0
+        };
+        constexpr Table Queen = {
+            -20, -10, -10,  -5,  -5, -10, -10, -20,
+            -10,   0,   0,   0,   0,   0,   0, -10,
+            -10,   0,   5,   5,   5,   5,   0, -10,
+             -5,   0,   5,   5,   5,   5,   0,  -5,
+              0,   0,   5,   5,   5,   5,   0,  -5,
+            -10,   5,   5,   5,   5,   5,   0, -10,
+            -10,   0,   5,   0,   0,   0,   0, -10,
+            -20, -10, -10,  -5,  -5, -10, -10, -20
+        };
+        constexpr Table KingMg = {
+            -30, -40, -40, -50, -50, -40, -40, -30,
+            -30, -40, -40, -50, -50, -40, -40, -30,
+            -30, -40, -40, -50, -50, -40, -40, -30,
+            -30, -40, -40, -50, -50, -40, -40, -30,
+            -20, -30, -30, -40, -40, -30, -30, -20,
+            -10, -20, -20, -20, -20, -20, -20, -10,
+             20,  20,   0,   0,   0,   0,  20,  20,
+             20,  30,  10,   0,   0,  10,  30,  20
+        };
+        constexpr Table KingEg = {
+            -50, -40, -30, -20, -20, -30, -40, -50,
+            -30, -20, -10,   0,   0, -10, -20, -30,
+            -30, -10,  20,  30,  30,  20, -10, -30,
+            -30, -10,  30,  40,  40,  30, -10, -30,
+            -30, -10,  30,  40,  40,  30, -10, -30,
+            -30, -10,  20,  30,  30,  20, -10, -30,
+            -30, -30,   0,   0,   0,   0, -30, -30,
+            -50, -30, -30, -30, -30, -30, -30, -50
+        };
+
+        constexpr const Table* MG_TABLES[PIECE_TYPE_COUNT] = { &PawnMg, &Knight, &Bishop, &Rook, &Queen, &KingMg };
+        constexpr const Table* EG_TABLES[PIECE_TYPE_COUNT] = { &PawnEg, &Knight, &Bishop, &Rook, &Queen, &KingEg };
+
+        constexpr std::array<std::array<Score, SQUARE_COUNT>, PIECE_COUNT> makeTable() {
+            std::array<std::array<Score, SQUARE_COUNT>, PIECE_COUNT> table{};
+            for (int type = 0; type < PIECE_TYPE_COUNT; type++) {
+                for (int square = 0; square < SQUARE_COUNT; square++) {
+                    // Case vue par chaque camp: a1 des blancs = index 56, a1 des noirs (a8) = index 0
+                    int whiteIndex = square ^ 56;
+                    int blackIndex = square;
+                    Score white = { MATERIAL[type].mg + (*MG_TABLES[type])[whiteIndex],
+                                    MATERIAL[type].eg + (*EG_TABLES[type])[whiteIndex] };
+                    Score black = { MATERIAL[type].mg + (*MG_TABLES[type])[blackIndex],
+                                    MATERIAL[type].eg + (*EG_TABLES[type])[blackIndex] };
+                    table[type][square] = white;
+                    table[PIECE_TYPE_COUNT + type][square] = -black;
+                }
+            }
+            return table;
+        }
+    }
+
+    // [pièce][case]: contribution signée (blancs positifs) de la pièce posée sur la case
+    inline constexpr std::array<std::array<Score, SQUARE_COUNT>, PIECE_COUNT> Table = detail::makeTable();
+
+    constexpr Score value(Piece piece, int square) { return Table[piece][square]; }
+    constexpr int phaseWeight(Piece piece) { return PHASE_WEIGHTS[piece % PIECE_TYPE_COUNT]; }
+}
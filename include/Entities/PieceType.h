@@ -0,0 +1,43 @@
+#pragma once
+
+#ifndef PIECETYPE_H
+#define PIECETYPE_H
+
+#include <cstdint>
+#include <string>
+#include "Color.h"
+
+enum class PieceType : uint8_t { Pawn, Knight, Bishop, Rook, Queen, King, None };
+
+constexpr int PIECE_TYPE_COUNT = 6;
+
+// Pièce codée sur un octet (couleur * 6 + type) pour la mailbox de Position.
+// Les index 0..11 servent directement d'index de tables (Zobrist, PST...).
+using Piece = uint8_t;
+
+constexpr Piece NO_PIECE = 12;
+constexpr int PIECE_COUNT = 12;
+
+constexpr int toIndex(PieceType type) {
+    return static_cast<int>(type);
+}
+
+constexpr Piece makePiece(Color color, PieceType type) {
+    return static_cast<Piece>(toIndex(color) * PIECE_TYPE_COUNT + toIndex(type));
+}
+
+constexpr PieceType typeOf(Piece piece) {
+    return piece == NO_PIECE ? PieceType::None
+                             : static_cast<PieceType>(piece % PIECE_TYPE_COUNT);
+}
+
+constexpr Color colorOf(Piece piece) {
+    return piece == NO_PIECE ? Color::None
+                             : (piece < PIECE_TYPE_COUNT ? Color::White : Color::Black);
+}
+
+// Conversion avec les noms utilisés par le GUI ("pawn", "knight", ...)
+std::string toString(PieceType type);
+PieceType pieceTypeFromString(const std::string& name);
+
+#endif // PIECETYPE_H
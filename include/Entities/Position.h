@@ -1 +1,145 @@
 #pragma once
+
+#include <cstdint>
+#include <string>
+#include "Bitboard.h"
+#include "Color.h"
+#include "PieceType.h"
+#include "PackedMove.h"
+#include "PieceSquareTables.h"
+
+// Droits de roque (masque de bits)
+enum CastlingRight : uint8_t {
+    NO_CASTLING = 0,
+    WHITE_KINGSIDE = 1,
+    WHITE_QUEENSIDE = 2,
+    BLACK_KINGSIDE = 4,
+    BLACK_QUEENSIDE = 8,
+    ALL_CASTLING = 15
+};
+
+// Profondeur maximale d'une recherche: taille des piles d'états préallouées
+constexpr int MAX_PLY = 128;
+
+/**
+ * @brief État irréversible sauvegardé par makeMove et restauré par unmakeMove
+ *
+ * La recherche garde une pile fixe `StateInfo states[MAX_PLY]` indexée par le ply:
+ * aucun makeMove/unmakeMove n'alloue de mémoire.
+ */
+struct StateInfo {
+    uint64_t key;
+    uint8_t castlingRights;
+    uint8_t enPassantSquare;
+    uint16_t halfMoveClock;
+    Piece capturedPiece;
+
+    // Pièces modifiées par le coup, pour les évaluations incrémentales (NNUE):
+    // from = NO_SQUARE pour une pièce posée, to = NO_SQUARE pour une pièce retirée
+    struct DirtyPiece {
+        Piece piece;
+        uint8_t from;
+        uint8_t to;
+    };
+    uint8_t dirtyCount;
+    DirtyPiece dirty[3];
+};
+
+/**
+ * @brief Position d'échecs compacte basée sur des bitboards
+ *
+ * Type valeur sans dépendance SFML: un bitboard par type de pièce et par couleur
+ * (pieces(color, type) = intersection des deux), une mailbox de 64 octets pour
+ * savoir en O(1) quelle pièce occupe une case, et l'état de la partie (trait,
+ * roques, prise en passant, compteurs). Une copie coûte environ 150 octets.
+ */
+class Position {
+public:
+    Position();
+
+    static Position startingPosition();
+    void clear();
+
+    // Notation FEN (outils, tests perft, sauvegarde). Renvoie false si la chaîne est invalide.
+    bool setFromFen(const std::string& fen);
+    std::string toFen() const;
+
+    // Placement des pièces (ne touche ni au trait ni aux droits)
+    void putPiece(Piece piece, int square);
+    void removePiece(int square);
+    void movePiece(int from, int to);
+
+    // Joue un coup pseudo-légal (roque, en passant et promotion inclus) et met à jour l'état.
+    // L'état précédent est écrit dans `state`, à repasser tel quel à unmakeMove.
+    void makeMove(PackedMove move, StateInfo& state);
+    void unmakeMove(PackedMove move, const StateInfo& state);
+
+    // Coup nul (le trait passe sans coup joué), pour l'élagage de la recherche
+    void makeNullMove(StateInfo& state);
+    void unmakeNullMove(const StateInfo& state);
+
+    // makeMove sans possibilité d'annulation (GUI, validation par copie)
+    void applyMove(PackedMove move);
+
+    // Accès aux pièces
+    Piece pieceOn(int square) const { return m_board[square]; }
+    bool isEmpty(int square) const { return m_board[square] == NO_PIECE; }
+    Bitboard pieces() const { return m_byColor[0] | m_byColor[1]; }
+    Bitboard pieces(Color color) const { return m_byColor[toIndex(color)]; }
+    Bitboard pieces(PieceType type) const { return m_byType[toIndex(type)]; }
+    Bitboard pieces(Color color, PieceType type) const {
+        return m_byColor[toIndex(color)] & m_byType[toIndex(type)];
+    }
+    int count(Color color, PieceType type) const { return popCount(pieces(color, type)); }
+    int kingSquare(Color color) const;
+
+    // État de la partie
+    Color sideToMove() const { return m_sideToMove; }
+    void setSideToMove(Color color);
+    uint8_t castlingRights() const { return m_castlingRights; }
+    void setCastlingRights(uint8_t rights);
+    void setCastlingRightsFromPlacement();
+    int enPassantSquare() const { return m_enPassantSquare; }
+    void setEnPassantSquare(int square);
+    int halfMoveClock() const { return m_halfMoveClock; }
+    void setHalfMoveClock(int clock) { m_halfMoveClock = static_cast<uint16_t>(clock); }
+    int fullMoveNumber() const { return m_fullMoveNumber; }
+
+    // Clé Zobrist 64 bits (pièces, trait, roques, colonne de prise en passant),
+    // mise à jour incrémentalement par chaque modification de la position
+    uint64_t key() const { return m_key; }
+    uint64_t computeKey() const;
+
+    // Clé Zobrist des seuls pions (table de hachage de la structure de pions)
+    uint64_t pawnKey() const { return m_pawnKey; }
+
+    // Évaluation incrémentale: matériel + tables pièce-case (blancs positifs, mg/eg)
+    // et phase de jeu, mises à jour à chaque pose, retrait ou déplacement de pièce
+    PieceSquare::Score psqScore() const { return m_psq; }
+    int gamePhase() const { return m_phase; }
+
+    // Détection d'attaques
+    Bitboard attackersTo(int square, Bitboard occupied) const;
+    bool isSquareAttacked(int square, Color attacker) const;
+    bool isInCheck(Color color) const;
+
+    // Échange statique (SEE) sur la case d'arrivée, en centipions du point de vue du camp
+    // qui joue le coup: séquence de prises par l'attaquant le moins cher, rayons X inclus.
+    // Négatif: le coup perd du matériel. Clouages et échecs ne sont pas pris en compte.
+    int staticExchange(PackedMove move) const;
+
+private:
+    Bitboard m_byType[PIECE_TYPE_COUNT];
+    Bitboard m_byColor[COLOR_COUNT];
+    Piece m_board[SQUARE_COUNT];
+
+    uint64_t m_key;
+    uint64_t m_pawnKey;
+    PieceSquare::Score m_psq;
+    int m_phase;
+    Color m_sideToMove;
+    uint8_t m_castlingRights;
+    uint8_t m_enPassantSquare;
+    uint16_t m_halfMoveClock;
+    uint16_t m_fullMoveNumber;
+};
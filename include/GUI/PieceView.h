@@ -2,25 +2,26 @@
 #define PIECEVIEW_H
 
 #include <SFML/Graphics.hpp>
-#include <string>
 
 struct ChessPiece;
 
+// Rendu d'une pièce: le sprite vit ici, pas dans ChessPiece (état de jeu sans SFML).
+// La texture est partagée et appartient à l'appelant (ChessBoard::pieceTextures).
 class PieceView {
 public:
-    explicit PieceView(ChessPiece* piece = nullptr);
+    explicit PieceView(const ChessPiece* piece = nullptr);
 
-    void setPiece(ChessPiece* p);
-    void loadTextureFromPiece();
-    void updatePosition(int boardX, int boardY);
-    void draw(sf::RenderWindow& window);
+    void setPiece(const ChessPiece* p);
+    const ChessPiece* getPiece() const { return m_piece; }
+
+    // Applique la texture et la met à l'échelle de la case (80 %), origine au centre
+    void setTexture(const sf::Texture& texture, float squareSize);
+    void setCenter(float x, float y);
+    void draw(sf::RenderWindow& window) const;
 
 private:
-    ChessPiece* m_piece{nullptr};
+    const ChessPiece* m_piece{nullptr};
     sf::Sprite m_sprite;
-    sf::Texture m_texture;
-
-    std::string texturePathForPiece() const; // helper to map piece to texture path
 };
 
 #endif // PIECEVIEW_H
@@ -1,34 +1,35 @@
 #pragma once
 
 #include <vector>
-#include <string>
 #include <utility>
 #include "Move.h"
+#include "Color.h"
+#include "MoveList.h"
 
-class ChessBoard;
-struct ChessPiece;
+class Position;
 
 class MoveValidator {
 public:
-    explicit MoveValidator(const ChessBoard* board);
+    explicit MoveValidator(const Position* position);
 
     // Main validation method
     bool isMoveLegal(const Move& move) const;
 
     // Check game states
-    bool isInCheck(const std::string& playerColor) const;
-    bool isCheckmate(const std::string& playerColor) const;
-    bool isStalemate(const std::string& playerColor) const;
+    bool isInCheck(Color color) const;
+    bool isCheckmate(Color color) const;
+    bool isStalemate(Color color) const;
 
     // Get valid moves
     std::vector<Move> getValidMovesForPiece(int row, int col) const;
-    std::vector<Move> getAllValidMovesForColor(const std::string& color) const;
+    std::vector<Move> getAllValidMovesForColor(Color color) const;
+    void getAllValidMovesForColor(Color color, MoveList& moves) const;
 
 private:
-    const ChessBoard* m_board;
+    const Position* m_position;
 
     // Helper methods
-    bool isPieceMoveLegal(const Move& move, const ChessPiece& piece) const;
-    bool wouldLeaveKingInCheck(const Move& move, const std::string& playerColor) const;
-    std::pair<int, int> findKing(const std::string& color) const;
+    const Position& position() const;
+    bool isPieceMoveLegal(const Move& move) const;
+    bool hasAnyLegalMove(Color color) const;
 };
@@ -1,10 +1,46 @@
 #pragma once
 
 #include "Move.h"
+#include "Color.h"
+#include "PackedMove.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
 
 // Forward declarations
-class ChessBoard;
+class Position;
+class OpeningBook;
+class EndgameBitbases;
+
+/**
+ * @brief Une variation de l'analyse MultiPV
+ */
+struct ProgressLine {
+    std::string score;     // "+0.35", "mate 3"...
+    std::string pv;
+};
+
+/**
+ * @brief Avancement d'une recherche, publié à chaque itération terminée
+ */
+struct SearchProgress {
+    int depth = 0;
+    int selDepth = 0;      // Ply le plus profond atteint, quiescence comprise
+    std::string score;     // "+0.35", "mate 3"...
+    std::string pv;        // Variation principale en notation UCI
+    uint64_t nodes = 0;
+    uint64_t nodesPerSecond = 0;
+    double seconds = 0.0;
+    std::vector<ProgressLine> lines;  // Meilleures variations (une seule hors analyse), lines[0] = score et pv
+};
 
 /**
  * @brief Interface commune pour tous les moteurs d'IA d'échecs
@@ -16,27 +52,217 @@ class AIEngine {
 public:
     /**
      * @brief Choisit le meilleur coup pour l'IA dans la position donnée
-     * @param board Référence constante vers l'état actuel du plateau
-     * @param playerColor Couleur du joueur IA ("white" ou "black")
+     * @param position Position actuelle (état de jeu sans dépendance graphique)
+     * @param color Couleur jouée par l'IA
      * @return Le coup choisi par l'IA
      */
-    virtual Move chooseMove(const ChessBoard& board, const std::string& playerColor) = 0;
+    virtual Move chooseMove(const Position& position, Color color) = 0;
+
+    /**
+     * @brief Indique le temps restant à la pendule de l'IA pour le prochain coup
+     * @param remainingSeconds Temps restant en secondes (0 = pas de pendule)
+     *
+     * Les moteurs qui ne gèrent pas le temps ignorent cette information.
+     */
+    virtual void setClockTime(double remainingSeconds) { (void)remainingSeconds; }
+
+    /**
+     * @brief Fixe la taille de la table de transposition
+     * @param megabytes Taille en Mo (les moteurs sans table l'ignorent)
+     */
+    virtual void setHashSize(size_t megabytes) { (void)megabytes; }
+
+    /**
+     * @brief Fixe le nombre de threads de recherche de cette instance
+     * @param threadCount Nombre de threads (1 = recherche sur le thread appelant seul)
+     */
+    virtual void setThreadCount(int threadCount) { (void)threadCount; }
+
+    /**
+     * @brief Remplace l'évaluation classique par un réseau NNUE
+     * @param path Fichier de poids (vide = revenir à l'évaluation classique)
+     * @return false si le moteur n'utilise pas de réseau ou si le fichier est invalide
+     *         (l'évaluation en place est alors conservée)
+     */
+    virtual bool setEvalFile(const std::string& path) { (void)path; return false; }
+
+    /**
+     * @brief Bitbases de finales sondées par la recherche
+     * @param bitbases Bitbases partagées (nullptr = aucune)
+     */
+    virtual void setBitbases(std::shared_ptr<const EndgameBitbases> bitbases) { (void)bitbases; }
+
+    /**
+     * @brief Positions déjà jouées dans la partie, pour que la recherche voie les répétitions
+     * @param keys Clés des positions de la partie jusqu'à la courante incluse (GameRecord::keyHistory)
+     *
+     * À fixer avant de lancer une recherche, un ponder ou une analyse.
+     */
+    virtual void setGameHistory(const std::vector<uint64_t>& keys) { (void)keys; }
+
+    /**
+     * @brief Livre d'ouvertures consulté avant toute recherche
+     * @param book Livre partagé (nullptr = pas de livre)
+     * @param sharpness Choix parmi les coups du livre: 0 = uniforme, 1 = proportionnel
+     *                  aux poids, plus = coups principaux favorisés (OpeningBook::pickMove)
+     */
+    void setOpeningBook(std::shared_ptr<const OpeningBook> book, double sharpness = 1.0);
+
+    /**
+     * @brief Lance chooseMove sur un thread de travail, sans bloquer l'appelant
+     * @param position Position copiée: la partie peut continuer d'évoluer pendant la recherche
+     * @param color Couleur jouée par l'IA
+     * @return Futur du coup choisi (coup (-1,-1,-1,-1) si aucun coup légal)
+     *
+     * Une recherche encore en cours est d'abord annulée.
+     */
+    std::future<Move> startSearch(const Position& position, Color color);
+
+    /**
+     * @brief Analyse la position sur un thread de travail, sans limite de profondeur utile
+     * @param position Position copiée, analysée pour le camp au trait
+     * @param lineCount Nombre de variations (MultiPV), meilleure en tête
+     * @return Futur de la dernière itération terminée, prêt après stopSearch()
+     *         (depth 0 si le moteur n'analyse pas)
+     *
+     * Chaque itération est publiée (getProgress, listener). Une recherche encore
+     * en cours est d'abord annulée.
+     */
+    std::future<SearchProgress> startAnalysis(const Position& position, int lineCount);
+
+    /**
+     * @brief Ponder: pendant que l'adversaire réfléchit, cherche déjà la position après sa
+     *        réponse attendue (deuxième coup de la variation du dernier coup choisi)
+     * @param position Position après le coup de l'IA, adversaire au trait
+     * @param color Couleur jouée par l'IA
+     * @return Futur du coup dans la position attendue; invalide (valid() == false) si aucune
+     *         réponse n'est prévue (coup du livre, moteur sans recherche, réponse illégale)
+     *
+     * Pas de limite de temps jusqu'à ponderHit(); la pendule de setClockTime vaut ensuite.
+     * Une recherche encore en cours est d'abord annulée. Annuler le ponder (cancelSearch)
+     * garde la table de transposition réchauffée.
+     */
+    std::future<Move> startPondering(const Position& position, Color color);
+
+    /**
+     * @brief L'adversaire a joué: si position est celle du ponder, la recherche de ponder
+     *        devient la recherche du coup (même futur, itérations déjà faites conservées)
+     * @return false si position n'est pas la position attendue (le ponder est à annuler)
+     */
+    bool ponderHit(const Position& position);
+
+    bool isPondering() const { return m_pondering.load(); }
+
+    // Réponse attendue du ponder en cours (PackedMove() sinon)
+    PackedMove ponderMove() const { return m_ponderMove; }
+
+    /**
+     * @brief Appelé à chaque avancement publié, sur le thread de la recherche
+     *
+     * À fixer avant de lancer une recherche (sortie en continu d'un outil en ligne de commande).
+     */
+    using ProgressListener = std::function<void(const SearchProgress&)>;
+    void setProgressListener(ProgressListener listener);
+
+    /**
+     * @brief Demande l'arrêt: la recherche rend au plus vite le meilleur coup trouvé
+     */
+    void stopSearch();
+
+    /**
+     * @brief Arrête la recherche en cours et attend la fin du thread (annulation, destruction)
+     */
+    void cancelSearch();
+
+    bool isSearching() const { return m_searching.load(); }
+
+    /**
+     * @brief Dernier avancement publié par la recherche en cours (copie, thread-safe)
+     */
+    SearchProgress getProgress() const;
 
     /**
      * @brief Destructeur virtuel pour assurer une destruction correcte
+     *
+     * Les classes dérivées dont chooseMove utilise des membres appellent
+     * cancelSearch() dans leur propre destructeur.
      */
-    virtual ~AIEngine() = default;
+    virtual ~AIEngine();
 
 protected:
     /**
      * @brief Constructeur protégé - cette classe est abstraite
      */
     AIEngine() = default;
+
+    // Signal d'arrêt levé par stopSearch(), à consulter par les recherches longues
+    const std::atomic<bool>& stopSignal() const { return m_stopRequested; }
+
+    // Levé pendant un ponder, baissé par ponderHit(): la pendule démarre
+    const std::atomic<bool>& ponderSignal() const { return m_pondering; }
+
+    // Réponse attendue de l'adversaire au dernier coup choisi (PackedMove() si aucune)
+    virtual PackedMove expectedReply() const { return PackedMove(); }
+
+    // Recherche du ponder, lancée par startPondering (voir ponderSignal)
+    virtual Move ponder(const Position& position, Color color) { return chooseMove(position, color); }
+
+    void publishProgress(const SearchProgress& progress);
+
+    /**
+     * @brief Analyse MultiPV bloquante, lancée par startAnalysis jusqu'à stopSignal()
+     *
+     * Seuls les moteurs qui cherchent l'implémentent.
+     */
+    virtual SearchProgress analyze(const Position& position, int lineCount) {
+        (void)position;
+        (void)lineCount;
+        return SearchProgress();
+    }
+
+    /**
+     * @brief Coup du livre pour color, à jouer sans recherche
+     * @return false si aucun livre ou si la position n'y est pas
+     */
+    bool probeBook(const Position& position, Color color, Move& move);
+
+private:
+    std::shared_ptr<const OpeningBook> m_book;
+    double m_bookSharpness = 1.0;
+    std::mt19937 m_bookRng{ std::random_device{}() };
+
+    std::thread m_worker;
+    std::atomic<bool> m_searching{ false };
+    std::atomic<bool> m_stopRequested{ false };
+    std::atomic<bool> m_pondering{ false };
+    uint64_t m_ponderKey = 0;   // Position attendue du ponder (0 = aucun ponder)
+    PackedMove m_ponderMove;
+    mutable std::mutex m_progressMutex;
+    SearchProgress m_progress;
+    ProgressListener m_progressListener;
+
+    // Exécute task sur le thread de travail (startSearch, startAnalysis, startPondering)
+    template <typename Result, typename Task>
+    std::future<Result> launch(Task task, bool pondering = false);
 };
 
 /**
  * @brief Factory pour créer des instances d'IA selon le niveau
  * @param difficulty Niveau de difficulté (1=Facile, 2=Moyen, 3=Difficile)
+ *
+ * Le niveau Difficile utilise le réseau DEFAULT_EVAL_FILE s'il est présent,
+ * l'évaluation classique sinon, et sonde les bitbases de DEFAULT_BITBASE_DIR.
+ * Les niveaux Moyen et Difficile jouent les coups du livre DEFAULT_BOOK_FILE
+ * tant que la partie y reste.
  * @return Pointeur unique vers l'instance d'IA appropriée
  */
 std::unique_ptr<AIEngine> createAIEngine(int difficulty);
+
+// Livre d'ouvertures des niveaux Moyen et Difficile (BookBuilder)
+inline const char* const DEFAULT_BOOK_FILE = "assets/book/book.bin";
+
+// Réseau NNUE du niveau Difficile, relatif au dossier de l'exécutable (comme les autres ressources)
+inline const char* const DEFAULT_EVAL_FILE = "assets/nnue/chess.nnue";
+
+// Bitbases de finales (BitbaseGen); KPK, KRK et KQK sont générées en mémoire si absentes
+inline const char* const DEFAULT_BITBASE_DIR = "assets/bitbases";
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Entities/Position.h"
+
+/**
+ * @brief Résultat théorique d'une fin de partie, pour le camp au trait
+ */
+enum class Wdl : int8_t {
+    Loss = -1,
+    Draw = 0,
+    Win = 1
+};
+
+/**
+ * @brief Bitbases de finales à 3 et 4 pièces (rois compris): gain, nulle ou perte
+ *
+ * Chaque table couvre un matériel ("KPK", "KQKR"...), camp fort en blanc, et
+ * donne le résultat de toutes ses positions, trait aux blancs et aux noirs.
+ * Les positions de l'autre camp sont lues en échangeant les couleurs.
+ *
+ * Index: trait, roi blanc ramené par symétrie dans a1-d1-d4 (10 cases; a1-d8
+ * avec pions, symétrie verticale seule), roi noir, puis les autres pièces
+ * (48 cases pour un pion). Deux bits par position en mémoire.
+ *
+ * Génération par analyse rétrograde itérative: une position est gagnée si un
+ * coup mène à une position perdue pour l'adversaire, perdue si tous ses coups
+ * mènent à des positions gagnées; on répète jusqu'à ce que plus rien ne change,
+ * le reste est nul. Les prises et promotions sortent de la table: leurs tables
+ * sont générées d'abord. Chaque passe est répartie entre plusieurs threads.
+ *
+ * Fichier (petit-boutiste): "CMBB", version (uint32), matériel (8 octets),
+ * nombre de positions (uint64), taille compressée (uint64), somme de contrôle
+ * FNV-1a des données (uint32), puis les deux bits par position compressés en
+ * PackBits. Les positions illégales reprennent la valeur de la précédente, ce
+ * qui allonge les plages identiques.
+ *
+ * Les tables trouvées par open() sont décompressées au premier accès. Ni la
+ * règle des 50 coups, ni le roque, ni la prise en passant n'y figurent: probe()
+ * refuse les positions avec droit de roque ou prise en passant possible.
+ *
+ * Une fois ouvertes, les bitbases sont en lecture seule: partagées entre les moteurs.
+ */
+class EndgameBitbases {
+public:
+    static constexpr int MAX_PIECES = 4;
+    static constexpr uint32_t VERSION = 1;
+
+    EndgameBitbases();
+    ~EndgameBitbases();
+    EndgameBitbases(const EndgameBitbases&) = delete;
+    EndgameBitbases& operator=(const EndgameBitbases&) = delete;
+
+    /**
+     * @brief Enregistre les tables (.bb) d'un dossier, chargées au premier accès
+     * @return Nombre de tables trouvées
+     */
+    int open(const std::string& directory);
+
+    /**
+     * @brief Génère en mémoire une table et celles dont elle dépend
+     * @param material Matériel, rois compris ("KRK", "kqkr"...), dans un sens ou dans l'autre
+     * @param threadCount Threads de génération (0 = tous les coeurs)
+     * @return false si le matériel n'est pas une finale à 3 ou 4 pièces avec des pièces à prendre
+     */
+    bool generate(const std::string& material, int threadCount = 0);
+
+    // Écrit la table material (générée ou chargée) dans directory/<matériel>.bb
+    bool save(const std::string& material, const std::string& directory) const;
+
+    bool contains(const std::string& material) const;
+    // Matériels disponibles (fichiers ouverts ou tables générées)
+    std::vector<std::string> materials() const;
+
+    /**
+     * @brief Résultat de la position pour le camp au trait
+     * @return false si aucune table ne couvre la position (plus de 4 pièces, table absente,
+     *         roque ou prise en passant possible)
+     */
+    bool probe(const Position& position, Wdl& result) const;
+
+    // Matériel canonique (camp fort en premier, pièces par valeur décroissante), vide si invalide
+    static std::string normalize(const std::string& material);
+    // Toutes les finales à générer jusqu'à maxPieces pièces (sans les nulles triviales KK, KNK, KBK)
+    static std::vector<std::string> allMaterials(int maxPieces = MAX_PIECES);
+
+    /**
+     * @brief Bitbases d'un dossier, partagées par tous les appelants tant que l'une d'elles vit
+     *
+     * Les tables à 3 pièces absentes du dossier (KPK, KRK, KQK) sont générées en
+     * mémoire: quelques dizaines de millisecondes.
+     */
+    static std::shared_ptr<const EndgameBitbases> openShared(const std::string& directory);
+
+private:
+    struct Table;
+    struct Setup;
+
+    // Une table par matériel canonique: jusqu'à deux pièces par camp, 6 valeurs chacune (0 = aucune)
+    static constexpr int MATERIAL_CODES = 6 * 6 * 6 * 6;
+    std::array<std::unique_ptr<Table>, MATERIAL_CODES> m_tables;
+
+    Table* tableFor(const std::string& material) const;
+    // Table utilisable (générée, en cours de génération, ou chargée à l'instant)
+    bool isReady(Table& table) const;
+    bool load(Table& table) const;
+    // Valeur de la position pour le camp au trait, dans la table de son matériel
+    uint8_t lookup(const Setup& setup) const;
+    uint8_t childValue(const Table& table, const Setup& parent, const Setup& child) const;
+    // Valeur d'une position de table déduite de ses fils, ou inconnue pour l'instant
+    uint8_t resolve(const Table& table, const Setup& setup) const;
+    void build(Table& table, int threadCount);
+};
@@ -1,9 +1,11 @@
 #pragma once
 
-#include <string>
+#include "Color.h"
+#include "PieceType.h"
 
 // Forward declarations
-class ChessBoard;
+class Position;
+class PawnHashTable;
 
 /**
  * @brief Évaluateur de positions d'échecs pour l'IA
@@ -15,43 +17,56 @@ class Evaluator {
 public:
     /**
      * @brief Évalue la position actuelle du plateau
-     * @param board Référence constante vers l'état du plateau
-     * @param playerColor Couleur du joueur à évaluer ("white" ou "black")
+     * @param position Position à évaluer
+     * @param color Couleur du joueur à évaluer
      * @return Score de la position (positif = avantage, négatif = désavantage)
      */
-    static double evaluatePosition(const ChessBoard& board, const std::string& playerColor);
+    static double evaluatePosition(const Position& position, Color color);
+
+    /**
+     * @brief Évaluation des feuilles de la recherche, en centipions
+     * @param position Position à évaluer
+     * @param pawnTable Cache de la structure de pions (nullptr: calculée à chaque appel)
+     * @return Score du point de vue du camp au trait: matériel et tables pièce-case
+     *         (incrémentaux, mélangés selon la phase de jeu), mobilité calculée sur
+     *         les bitboards d'attaque et structure de pions; les échecs sont résolus
+     *         par la recherche
+     */
+    static int evaluate(const Position& position, PawnHashTable* pawnTable = nullptr);
 
     /**
      * @brief Calcule la valeur matérielle totale d'un joueur
-     * @param board Référence constante vers l'état du plateau
-     * @param playerColor Couleur du joueur ("white" ou "black")
+     * @param position Position à évaluer
+     * @param color Couleur du joueur
      * @return Valeur matérielle totale
      */
-    static double getMaterialValue(const ChessBoard& board, const std::string& playerColor);
+    static double getMaterialValue(const Position& position, Color color);
 
     /**
-     * @brief Évalue la mobilité (nombre de coups possibles) d'un joueur
-     * @param board Référence constante vers l'état du plateau
-     * @param playerColor Couleur du joueur ("white" ou "black")
+     * @brief Évalue la mobilité d'un joueur (cases atteintes par ses pièces hors pions et roi,
+     *        sauf les siennes et celles tenues par un pion adverse)
+     * @param position Position à évaluer
+     * @param color Couleur du joueur
      * @return Score de mobilité
      */
-    static double getMobilityScore(const ChessBoard& board, const std::string& playerColor);
+    static double getMobilityScore(const Position& position, Color color);
 
     /**
      * @brief Évalue la sécurité du roi
-     * @param board Référence constante vers l'état du plateau
-     * @param playerColor Couleur du joueur ("white" ou "black")
+     * @param position Position à évaluer
+     * @param color Couleur du joueur
      * @return Score de sécurité du roi (positif = sécurisé, négatif = exposé)
      */
-    static double getKingSafetyScore(const ChessBoard& board, const std::string& playerColor);
+    static double getKingSafetyScore(const Position& position, Color color);
 
     /**
      * @brief Obtient la valeur d'une pièce selon son type
-     * @param pieceType Type de la pièce ("pawn", "rook", "knight", "bishop", "queen", "king")
+     * @param pieceType Type de la pièce (PieceType::None vaut 0)
      * @return Valeur numérique de la pièce
      */
-    static double getPieceValue(const std::string& pieceType);
+    static double getPieceValue(PieceType pieceType);
 
 private:
-    // Méthodes privées d'aide si nécessaire
+    // Score tapered du point de vue des blancs, en centipions
+    static int evaluateForWhite(const Position& position, PawnHashTable* pawnTable);
 };
@@ -11,10 +11,12 @@
 #include <vector>
 #include <utility>
 #include <memory>
+#include <future>
+#include "AIEngine.h"
 
 // Forward declarations
 class ScoreSystem;
-class AIEngine;
+class EndgameBitbases;
 
 class GameController {
 private:
@@ -46,6 +48,7 @@ private:
     // Game End Evaluation
     std::unique_ptr<MoveValidator> moveValidator;
     std::unique_ptr<GameEndEvaluator> gameEndEvaluator;
+    std::shared_ptr<const EndgameBitbases> bitbases;  // Adjudication des finales, parties contre l'IA
     GameResult currentGameResult;
     GameEndReason currentEndReason;
     
@@ -57,7 +60,16 @@ private:
     bool aiEnabled;
     std::string aiColor;  // Couleur de l'IA ("white" ou "black")
     bool aiThinking;      // Flagpour indiquer que l'IA réfléchit
-    float aiThinkingTimer; // Timer pour simuler le temps de réflexion
+    float aiThinkingTimer; // Budget de temps de la recherche en cours (secondes)
+    std::future<Move> aiSearch;  // Coup de la recherche lancée sur le thread de l'IA
+    bool ponderEnabled;   // Ponder: l'IA cherche pendant le temps de réflexion du joueur
+    bool aiPondering;     // aiSearch est une recherche de ponder (tour du joueur)
+    
+    // Analysis mode: MultiPV search on its own engine, restarted whenever the position changes
+    std::unique_ptr<AIEngine> analysisEngine;
+    std::future<SearchProgress> analysisSearch;
+    int analysisLines;
+    uint64_t analysisKey;  // Position en cours d'analyse
     
     // Chess Clock System
     ChessClock chessClock;
@@ -96,8 +108,17 @@ public:
     void enableAI(bool enable, const std::string& color = "black");
     void disableAI();
     bool isAITurn() const;
-    void startAIThinking();  // Démarre explicitement la réflexion IA
-    void processAIMove();
+    void startAIThinking();  // Lance la recherche IA en arrière-plan
+    void processAIMove();    // Joue le coup de l'IA dès que la recherche est terminée
+    SearchProgress getAIProgress() const;  // Profondeur, score et variation en cours
+    void setPonderEnabled(bool enable);
+    bool isAIPondering() const { return aiPondering; }
+    
+    // Analysis Mode (MultiPV), independent of the AI opponent
+    void startAnalysis(int lineCount = 3);
+    void stopAnalysis();
+    bool isAnalyzing() const { return analysisEngine != nullptr; }
+    SearchProgress getAnalysis() const;  // Dernière itération publiée, une ligne par variation
     
     // Getters
     ChessBoard& getBoard() { return chessBoard; }
@@ -110,7 +131,7 @@ public:
     bool isAIEnabled() const { return aiEnabled; }
     bool isAIThinking() const { return aiThinking; }
     const std::string& getAIColor() const { return aiColor; }
-    float getAIThinkingTimeRemaining() const { return aiThinkingTimer; }
+    float getAIThinkingTimeRemaining() const { return aiThinkingTimer; }  // Budget de la recherche
     
     // Game State Getters
     GameState getGameState() const { return currentGameState; }
@@ -156,6 +177,10 @@ private:
     void clearLegalMoves();
     void initializeAI();
     void executeAIMove(const Move& move);
+    void cancelAIThinking();  // Annulation: annuler, nouvelle partie, pause, fin de partie
+    void startAIPondering();  // Après le coup de l'IA: cherche la réponse attendue du joueur
+    void restartAnalysis();   // Analyse de la position courante
+    const PlayerClock& getAIClock() const;
     void evaluateGameEnd();
     void handleGameEnd(const std::string& winnerName, const std::string& loserName);
 };
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <memory>
 #include <string>
-#include <map>
+#include "Color.h"
+#include "PieceType.h"
 
-class ChessBoard;
+class GameRecord;
 class MoveValidator;
+class EndgameBitbases;
 
 // Énumération pour les résultats de partie
 enum class GameResult {
@@ -23,7 +26,8 @@ enum class GameEndReason {
     FIFTY_MOVE_RULE,        // Règle des 50 coups
     THREEFOLD_REPETITION,   // Triple répétition
     RESIGNATION,            // Abandon (si implémenté)
-    TIMEOUT                 // Dépassement de temps (si implémenté)
+    TIMEOUT,                // Dépassement de temps (si implémenté)
+    ADJUDICATION            // Finale résolue par les bitbases
 };
 
 /**
@@ -32,57 +36,49 @@ enum class GameEndReason {
  */
 class GameEndEvaluator {
 public:
-    GameEndEvaluator(const ChessBoard* board, const MoveValidator* validator);
+    GameEndEvaluator(const GameRecord* game, const MoveValidator* validator);
+    
+    // Bitbases de finales: une position couverte termine la partie sur son résultat théorique
+    void setBitbases(std::shared_ptr<const EndgameBitbases> bitbases) { m_bitbases = std::move(bitbases); }
     
     // Méthode principale d'évaluation
-    GameResult evaluateGameState(const std::string& currentPlayerColor);
+    GameResult evaluateGameState(Color currentPlayer);
     
     // Getter pour la raison de fin
     GameEndReason getEndReason() const { return m_endReason; }
     
     // Vérifications spécifiques des cas de fin de partie
-    bool isCheckmate(const std::string& playerColor) const;
-    bool isStalemate(const std::string& playerColor) const;
+    bool isCheckmate(Color color) const;
+    bool isStalemate(Color color) const;
     bool hasInsufficientMaterial() const;
     bool isFiftyMoveRule() const;
     bool isThreefoldRepetition() const;
+    // Résultat théorique si la position est dans les bitbases
+    bool isAdjudicated(Color currentPlayer, GameResult& result) const;
     
     // Obtenir une description textuelle du résultat
     std::string getResultDescription() const;
     
-    // Mise à jour des compteurs (appelée après chaque coup)
-    void updateAfterMove(bool isPawnMove, bool isCapture);
-    
-    // Enregistrer la position actuelle pour la détection de répétition
-    void recordCurrentPosition();
-    
     // Réinitialiser l'état
     void reset();
 
 private:
-    const ChessBoard* m_board;
+    const GameRecord* m_game;
     const MoveValidator* m_validator;
+    std::shared_ptr<const EndgameBitbases> m_bitbases;
     
     GameResult m_currentResult;
     GameEndReason m_endReason;
     
-    // Compteur pour la règle des 50 coups
-    int m_halfMoveClock;
-    
-    // Historique des positions pour la triple répétition
-    // Clé: hash de la position, Valeur: nombre d'occurrences
-    std::map<std::string, int> m_positionHistory;
-    
     // Méthodes privées d'aide
-    std::string generatePositionHash() const;
     bool hasOnlyKings() const;
     bool hasKingVsKingBishop() const;
     bool hasKingVsKingKnight() const;
     bool hasKingBishopVsKingBishop() const;
     
     // Compte le nombre de pièces d'un type et couleur donnés
-    int countPieces(const std::string& type, const std::string& color) const;
+    int countPieces(PieceType type, Color color) const;
     
     // Vérifie si tous les fous d'une couleur sont sur la même couleur de case
-    bool allBishopsOnSameColorSquares(const std::string& color) const;
+    bool allBishopsOnSameColorSquares(Color color) const;
 };
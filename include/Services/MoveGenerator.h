@@ -3,15 +3,38 @@
 #include <vector>
 #include <string>
 #include "Color.h"
+#include "Bitboard.h"
+#include "MoveList.h"
 
-class ChessBoard;
+class Position;
 struct Move;
-enum class SpecialMoveType;
+
+// Sous-ensemble de coups à générer (quiescence, sélection des coups par étapes)
+enum class MoveGenType {
+    All,
+    Captures,  // Prises, prise en passant et toutes les promotions
+    Quiets     // Le reste: déplacements sans prise, roques
+};
 
 class MoveGenerator {
 public:
-    explicit MoveGenerator(const ChessBoard* board);
+    explicit MoveGenerator(const Position& position);
+
+    // Coups pseudo-légaux compacts, sans allocation (recherche, validation)
+    void generateMoves(Color color, MoveList& moves) const;
+    void generateMovesFrom(int square, MoveList& moves) const;
+
+    // Coups strictement légaux en une passe: échecs, clouages et masque de parade
+    // sont calculés une fois par position, sans simuler chaque coup
+    void generateLegalMoves(Color color, MoveList& moves, MoveGenType type = MoveGenType::All) const;
+
+    // Prise ou promotion (classement MoveGenType::Captures)
+    bool isTactical(PackedMove move) const;
 
+    // Coup légal pour le camp au trait (coup venu d'ailleurs: table, killers)
+    bool isLegal(PackedMove move) const;
+
+    // Adaptateurs vers l'ancienne structure Move (GUI)
     std::vector<Move> generateMovesForPiece(int row, int col) const;
     std::vector<Move> generateMovesForColor(Color color) const;
     bool isSquareAttacked(int row, int col, Color attacker) const;
@@ -20,29 +43,24 @@ public:
     bool canPieceAttackSquare(int fromRow, int fromCol, int toRow, int toCol) const;
 
 private:
-    const ChessBoard* m_board;
+    const Position& m_position;
+
+    // Cases attaquées par la pièce posée sur square (bitboards)
+    Bitboard attacksFrom(int square) const;
 
-    void generatePawnMoves(int row, int col, std::vector<Move>& out) const;
-    void generateKnightMoves(int row, int col, std::vector<Move>& out) const;
-    void generateKingMoves(int row, int col, std::vector<Move>& out) const;
-    void generateRookMoves(int row, int col, std::vector<Move>& out) const;
-    void generateBishopMoves(int row, int col, std::vector<Move>& out) const;
-    void generateQueenMoves(int row, int col, std::vector<Move>& out) const;
+    void addMoves(int from, Bitboard targets, MoveList& moves) const;
+    void generatePawnMoves(int square, MoveList& moves) const;
+    void addPawnMove(int from, int to, MoveList& moves) const;
+
+    // Génération légale
+    Bitboard pinnedPieces(Color color, int kingSquare) const;
+    void generateLegalPawnMoves(int square, Bitboard targetMask, Bitboard pinMask,
+                                Bitboard checkers, MoveGenType type, MoveList& moves) const;
+    bool isLegalEnPassant(int from, Bitboard checkers) const;
 
     // Special move generation
-    void generateCastlingMoves(int row, int col, std::vector<Move>& out) const;
-    bool canCastle(int kingRow, int kingCol, bool kingside) const;
-
-    // Attack detection helpers
-    bool canPawnAttack(int fromRow, int fromCol, int toRow, int toCol, const std::string& color) const;
-    bool canKnightAttack(int fromRow, int fromCol, int toRow, int toCol) const;
-    bool canBishopAttack(int fromRow, int fromCol, int toRow, int toCol) const;
-    bool canRookAttack(int fromRow, int fromCol, int toRow, int toCol) const;
-    bool canQueenAttack(int fromRow, int fromCol, int toRow, int toCol) const;
-    bool canKingAttack(int fromRow, int fromCol, int toRow, int toCol) const;
-
-    // Path validation helpers
-    bool isDiagonalPath(int fromRow, int fromCol, int toRow, int toCol) const;
-    bool isStraightPath(int fromRow, int fromCol, int toRow, int toCol) const;
-    bool isPathClear(int fromRow, int fromCol, int toRow, int toCol) const;
+    void generateCastlingMoves(int square, MoveList& moves) const;
+    bool canCastle(int kingSquare, bool kingside) const;
+
+    std::vector<Move> toLegacyMoves(const MoveList& moves) const;
 };
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include "Entities/Position.h"
+#include "MoveList.h"
+
+/**
+ * @brief Historique « butterfly »: score de chaque coup calme [camp][départ][arrivée]
+ *
+ * Augmenté quand un coup calme provoque une coupure, diminué pour les coups
+ * calmes essayés avant lui. La mise à jour sature vers ±MAX_VALUE, ce qui
+ * garde les scores bornés sans remise à zéro.
+ */
+class ButterflyHistory {
+public:
+    static constexpr int MAX_VALUE = 16384;
+
+    int get(Color color, PackedMove move) const {
+        return m_table[toIndex(color)][move.from()][move.to()];
+    }
+    void update(Color color, PackedMove move, int bonus);
+
+    void clear();
+    // Entre deux recherches: l'historique compte encore, mais moins
+    void age();
+
+private:
+    int16_t m_table[COLOR_COUNT][SQUARE_COUNT][SQUARE_COUNT] = {};
+};
+
+/**
+ * @brief Sélection des coups par étapes, pour la recherche alpha-bêta
+ *
+ * Ordre: coup de la table de transposition, bonnes prises (MVV-LVA, échange
+ * statique positif ou nul), coups « killer », coup de réfutation (countermove),
+ * coups calmes triés par historique, puis prises perdantes.
+ *
+ * La génération est paresseuse: les prises ne sont générées qu'après le coup
+ * de la table, les coups calmes qu'après les killers. Une coupure obtenue tôt
+ * évite donc de générer le reste. Les coups proposés hors génération (table,
+ * killers, countermove) sont vérifiés avant d'être rendus, et jamais rendus deux fois.
+ *
+ * En quiescence, seules les bonnes prises et promotions sont rendues, sauf en
+ * échec où toutes les parades le sont.
+ */
+class MovePicker {
+public:
+    // Recherche principale; killers: tableau de 2 coups (ou nullptr)
+    MovePicker(const Position& position, PackedMove ttMove, const ButterflyHistory& history,
+               const PackedMove* killers = nullptr, PackedMove counterMove = PackedMove());
+
+    // Quiescence
+    MovePicker(const Position& position, const ButterflyHistory& history);
+
+    // Coup suivant, PackedMove() quand il n'y en a plus
+    PackedMove next();
+
+private:
+    enum class Stage {
+        TTMove,
+        GenerateCaptures,
+        GoodCaptures,
+        Killer1,
+        Killer2,
+        CounterMove,
+        GenerateQuiets,
+        Quiets,
+        BadCaptures,
+        Done
+    };
+
+    const Position& m_position;
+    const ButterflyHistory& m_history;
+    Stage m_stage = Stage::TTMove;
+    bool m_quiescence = false;
+    bool m_inCheck = false;
+
+    PackedMove m_ttMove;
+    PackedMove m_killers[2];
+    PackedMove m_counterMove;
+
+    MoveList m_moves;      // Étape courante (prises, puis coups calmes)
+    int m_scores[MAX_MOVES];
+    int m_current = 0;
+    MoveList m_badCaptures;
+    int m_badCurrent = 0;
+
+    PackedMove pickBest();
+    bool isRefutation(PackedMove move) const;
+    bool isValidSpecial(PackedMove move) const;
+};
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Entities/Position.h"
+
+/**
+ * Évaluation par réseau de neurones à mise à jour efficace (NNUE)
+ *
+ * Architecture HalfKP: pour chaque camp (perspective), une entrée par triplet
+ * (case de son roi, pièce hors roi, case de la pièce), soit 64 × 640 entrées.
+ * La première couche (feature transformer, 40960 → 256) est tenue à jour
+ * incrémentalement: un coup ne change que deux ou trois entrées, donc on ajoute
+ * ou retire quelques colonnes de poids au lieu de tout recalculer. Seul un coup
+ * du roi d'un camp oblige à recalculer sa moitié.
+ *
+ * Les deux moitiés (camp au trait d'abord) passent ensuite par une petite pile
+ * dense 512 → 32 → 32 → 1, avec ReLU bornée entre chaque couche.
+ *
+ * Poids quantifiés: int16 pour la première couche (activations à l'échelle 127),
+ * int8 pour les couches denses (échelle 64, d'où le décalage de 6 bits), biais
+ * int32. Les noyaux vectoriels (AVX2, SSE4.1) sont choisis à l'exécution selon
+ * le processeur, avec un repli scalaire; tous donnent exactement le même résultat.
+ */
+namespace Nnue {
+
+    constexpr int KING_SQUARES = SQUARE_COUNT;
+    constexpr int PIECE_FEATURES = 10 * SQUARE_COUNT;            // 5 types × 2 camps × 64 cases
+    constexpr int INPUT_SIZE = KING_SQUARES * PIECE_FEATURES;     // 40960
+    constexpr int HALF_SIZE = 256;                                // Sortie du feature transformer, par perspective
+    constexpr int L1_SIZE = 32;
+    constexpr int L2_SIZE = 32;
+
+    constexpr int ACTIVATION_MAX = 127;  // ReLU bornée, en uint8
+    constexpr int WEIGHT_SHIFT = 6;      // Poids des couches denses ×64
+    constexpr int OUTPUT_SCALE = 16;     // Sortie du réseau / 16 = centipions
+
+    // Entrée HalfKP d'une pièce (hors roi) vue par perspective, dont le roi est sur kingSquare
+    int featureIndex(Color perspective, int kingSquare, Piece piece, int square);
+
+    /**
+     * @brief Jeu d'instructions des noyaux de calcul
+     */
+    enum class Backend {
+        Scalar,
+        Sse41,
+        Avx2
+    };
+
+    // Meilleur jeu supporté par le processeur (et par le compilateur)
+    Backend detectBackend();
+    // Choix explicite (bancs d'essai, vérifications); un jeu non supporté retombe sur Scalar
+    void setBackend(Backend backend);
+    Backend activeBackend();
+    const char* backendName(Backend backend);
+
+    /**
+     * @brief Une perspective par camp, biais et colonnes des entrées actives
+     */
+    struct alignas(64) Accumulator {
+        int16_t values[COLOR_COUNT][HALF_SIZE];
+        bool computed[COLOR_COUNT] = { false, false };
+    };
+
+    /**
+     * @brief Poids du réseau, chargés depuis un fichier
+     *
+     * Format (petit-boutiste): "CMNN", version (uint32), INPUT_SIZE, HALF_SIZE,
+     * L1_SIZE, L2_SIZE (uint32), puis biais et poids de chaque couche dans l'ordre:
+     * feature transformer (int16 biais[HALF], int16 poids[INPUT][HALF]),
+     * couche 1 (int32 biais[L1], int8 poids[L1][2·HALF]), couche 2 (int32 biais[L2],
+     * int8 poids[L2][L1]), sortie (int32 biais, int8 poids[L2]).
+     *
+     * Une fois chargé, le réseau est en lecture seule: partagé par tous les threads.
+     */
+    class Network {
+    public:
+        static constexpr uint32_t VERSION = 1;
+
+        bool load(const std::string& path);
+        bool isLoaded() const { return m_loaded; }
+        const std::string& path() const { return m_path; }
+
+        // Accumulateur complet d'une perspective (tous les poids des pièces présentes)
+        void refresh(const Position& position, Color perspective, Accumulator& accumulator) const;
+        // Score en centipions du point de vue de sideToMove, à partir d'un accumulateur à jour
+        int evaluate(const Accumulator& accumulator, Color sideToMove) const;
+        // Évaluation sans état incrémental: deux rafraîchissements complets
+        int evaluate(const Position& position) const;
+
+        const int16_t* featureWeights(int feature) const { return &m_featureWeights[static_cast<size_t>(feature) * HALF_SIZE]; }
+
+    private:
+        bool m_loaded = false;
+        std::string m_path;
+
+        std::vector<int16_t> m_featureBiases;
+        std::vector<int16_t> m_featureWeights;
+        std::vector<int32_t> m_l1Biases;
+        std::vector<int8_t> m_l1Weights;
+        std::vector<int32_t> m_l2Biases;
+        std::vector<int8_t> m_l2Weights;
+        int32_t m_outputBias = 0;
+        std::vector<int8_t> m_outputWeights;
+    };
+
+    /**
+     * @brief Accumulateurs de la variation courante, un niveau par demi-coup
+     *
+     * push() est appelé après Position::makeMove (ou makeNullMove) avec son StateInfo,
+     * qui décrit les pièces déplacées; pop() après unmakeMove. Rien n'est calculé
+     * à ce moment: evaluate() met à jour paresseusement la perspective demandée
+     * depuis le dernier niveau calculé, ou la recalcule si son roi a bougé depuis.
+     * Les noeuds jamais évalués (coupés avant) ne coûtent donc rien.
+     */
+    class AccumulatorStack {
+    public:
+        AccumulatorStack();
+
+        void setNetwork(const Network* network) { m_network = network; }
+
+        // Nouvelle racine: tout sera recalculé à la première évaluation
+        void reset();
+        void push(const StateInfo& state);
+        void pop();
+
+        // Score en centipions du point de vue du camp au trait de position (position courante de la pile)
+        int evaluate(const Position& position);
+
+    private:
+        struct Level {
+            Accumulator accumulator;
+            StateInfo::DirtyPiece dirty[3];
+            uint8_t dirtyCount = 0;
+        };
+
+        const Network* m_network = nullptr;
+        std::unique_ptr<Level[]> m_levels;
+        int m_top = 0;
+
+        void update(const Position& position, Color perspective);
+    };
+
+    /**
+     * @brief Noyaux de calcul, une implémentation par jeu d'instructions
+     */
+    struct Kernels {
+        void (*addWeights)(int16_t* accumulator, const int16_t* weights);       // HALF_SIZE valeurs
+        void (*subtractWeights)(int16_t* accumulator, const int16_t* weights);
+        void (*clippedRelu)(const int16_t* input, uint8_t* output);             // HALF_SIZE valeurs, bornées 0..127
+        // output[j] = biases[j] + Σ input[i]·weights[j·inputSize + i]; inputSize multiple de 32, outputSize de 4
+        void (*affine)(const uint8_t* input, int inputSize, const int8_t* weights,
+                       const int32_t* biases, int32_t* output, int outputSize);
+    };
+
+    const Kernels& kernels();
+}
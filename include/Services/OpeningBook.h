@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "Entities/Position.h"
+
+/**
+ * @brief Coup du livre avec son poids
+ */
+struct BookMove {
+    PackedMove move;
+    uint16_t weight = 0;
+};
+
+/**
+ * @brief Livre d'ouvertures au format Polyglot (.bin), projeté en mémoire
+ *
+ * Le fichier est une suite d'entrées de 16 octets gros-boutistes (clé 64 bits,
+ * coup 16 bits, poids 16 bits, apprentissage 32 bits), triées par clé. Il est
+ * projeté en mémoire (mmap / MapViewOfFile) sans être lu: une recherche est une
+ * dichotomie sur la clé, quelques microsecondes même pour un gros livre, et
+ * seules les pages touchées sont chargées.
+ *
+ * Clé: schéma Polyglot (pièces, roques, colonne en passant seulement si une
+ * prise en passant est possible, trait aux blancs) sur la table Random64 publiée
+ * de Polyglot: les livres .bin existants sont lisibles tels quels. Coups: codage
+ * Polyglot (roque noté roi prend tour, e1h1).
+ *
+ * Un livre ouvert est en lecture seule: partagé entre les moteurs.
+ */
+class OpeningBook {
+public:
+    // Entrée décodée; l'ordre du fichier est celui de key, puis des poids décroissants
+    struct Entry {
+        uint64_t key = 0;
+        uint16_t move = 0;
+        uint16_t weight = 0;
+        uint32_t learn = 0;
+    };
+    static constexpr size_t ENTRY_SIZE = 16;
+
+    OpeningBook() = default;
+    ~OpeningBook();
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+    size_t size() const { return m_count; }
+    const std::string& path() const { return m_path; }
+
+    // Coups du livre légaux dans position, poids décroissants (vide si la position est absente)
+    std::vector<BookMove> probe(const Position& position) const;
+
+    /**
+     * @brief Tire un coup du livre au hasard, pondéré par les poids
+     * @param sharpness Exposant appliqué aux poids: 0 = uniforme, 1 = proportionnel,
+     *                  au-delà les coups principaux sont de plus en plus favorisés
+     * @return PackedMove() si la position n'est pas dans le livre
+     */
+    PackedMove pickMove(const Position& position, std::mt19937& rng, double sharpness = 1.0) const;
+
+    static uint64_t hashKey(const Position& position);
+    static uint16_t encodeMove(PackedMove move);
+    // Coup légal correspondant dans position, PackedMove() sinon
+    static PackedMove decodeMove(uint16_t move, const Position& position);
+
+    // Écrit entries triées au format Polyglot
+    static bool write(const std::string& path, std::vector<Entry> entries);
+
+private:
+    std::string m_path;
+    const unsigned char* m_data = nullptr;
+    size_t m_count = 0;
+    size_t m_mappedSize = 0;
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#else
+    int m_file = -1;
+#endif
+
+    Entry entryAt(size_t index) const;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "Search.h"
+#include "TranspositionTable.h"
+
+/**
+ * @brief Recherche Lazy SMP: plusieurs Search sur la même racine, une table partagée
+ *
+ * Le thread appelant conduit la recherche principale (gestion du temps, limites);
+ * les threads auxiliaires explorent la même position à des profondeurs décalées
+ * et enrichissent la table de transposition commune. Quand la recherche principale
+ * se termine (limites atteintes ou signal externe), un signal partagé arrête les
+ * auxiliaires. Le résultat retenu est celui de la plus grande profondeur terminée
+ * (le principal en cas d'égalité); en MultiPV, toujours celui du principal.
+ *
+ * Avec un seul thread, le comportement est exactement celui de Search.
+ */
+class ParallelSearch {
+public:
+    explicit ParallelSearch(TranspositionTable& table, int threadCount = 1);
+
+    void setThreadCount(int threadCount);
+    int threadCount() const { return static_cast<int>(m_searches.size()); }
+
+    // Techniques sélectives, appliquées à tous les threads
+    void setOptions(const SearchOptions& options);
+
+    // Réseau NNUE partagé par tous les threads (nullptr: évaluation classique)
+    void setNetwork(const Nnue::Network* network);
+
+    // Bitbases partagées par tous les threads (nullptr: aucun sondage)
+    void setBitbases(const EndgameBitbases* bitbases);
+
+    // Signal externe (interface, annulation) qui interrompt la recherche principale
+    void setAbortSignal(const std::atomic<bool>* abort);
+
+    // Signal de ponder partagé par tous les threads: aucun ne s'arrête sur le temps avant le ponderhit
+    void setPonderSignal(const std::atomic<bool>* pondering);
+
+    // Avancement de la recherche principale, itération par itération
+    void setProgressCallback(Search::ProgressCallback callback);
+
+    // Appelle table.newSearch(), puis recherche avec tous les threads (history: voir Search::run)
+    SearchResult run(const Position& position, const SearchLimits& limits,
+                     const std::vector<uint64_t>& history = {});
+
+private:
+    TranspositionTable& m_table;
+    std::vector<std::unique_ptr<Search>> m_searches;  // [0] = recherche principale
+    std::atomic<bool> m_stop{ false };                // Arrêt des auxiliaires
+    const std::atomic<bool>* m_abort = nullptr;
+    const std::atomic<bool>* m_pondering = nullptr;
+    Search::ProgressCallback m_progressCallback;
+    SearchOptions m_options;
+    const Nnue::Network* m_network = nullptr;
+    const EndgameBitbases* m_bitbases = nullptr;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "Entities/Position.h"
+
+/**
+ * @brief Structure de pions évaluée pour une clé de pions donnée
+ *
+ * Scores par camp (point de vue de ce camp): pions doublés, isolés, arriérés
+ * et passés. Le bouclier de pions devant le roi dépend aussi de la case du roi:
+ * il est mémorisé pour la dernière case vue de chaque roi.
+ */
+struct PawnEntry {
+    uint64_t key = 0;
+    PieceSquare::Score scores[COLOR_COUNT];
+    Bitboard passedPawns[COLOR_COUNT] = {};
+
+    int kingSquare[COLOR_COUNT] = { NO_SQUARE, NO_SQUARE };
+    PieceSquare::Score kingShield[COLOR_COUNT];
+
+    // Bouclier du roi de color, recalculé seulement si le roi a changé de case
+    PieceSquare::Score shield(const Position& position, Color color);
+};
+
+/**
+ * @brief Table de hachage de la structure de pions
+ *
+ * Indexée par Position::pawnKey(). Les pions bougent rarement d'un noeud à
+ * son voisin: la plupart des évaluations retrouvent leur entrée sans rien
+ * recalculer. Une table par thread de recherche (pas de partage, pas de verrou);
+ * une entrée d'une autre structure est simplement remplacée.
+ */
+class PawnHashTable {
+public:
+    static constexpr size_t DEFAULT_ENTRIES = 16384;  // 1 Mo
+
+    explicit PawnHashTable(size_t entries = DEFAULT_ENTRIES);
+
+    // Entrée de la structure de pions de position, calculée si absente
+    PawnEntry& probe(const Position& position);
+    void clear();
+
+    uint64_t probes() const { return m_probes; }
+    uint64_t hits() const { return m_hits; }
+
+    // Évaluation complète de la structure de pions (sans table)
+    static void evaluate(const Position& position, PawnEntry& entry);
+
+private:
+    std::unique_ptr<PawnEntry[]> m_entries;
+    size_t m_mask = 0;
+    uint64_t m_probes = 0;
+    uint64_t m_hits = 0;
+};
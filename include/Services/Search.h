@@ -0,0 +1,243 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Entities/Position.h"
+#include "EndgameBitbases.h"
+#include "MoveList.h"
+#include "MovePicker.h"
+#include "Nnue.h"
+#include "PawnHashTable.h"
+#include "TranspositionTable.h"
+
+// Bornes des scores de recherche (centipions, point de vue du camp au trait)
+constexpr int INFINITE_SCORE = 32001;
+constexpr int MATE_SCORE = 32000;
+constexpr int MATE_BOUND = MATE_SCORE - MAX_PLY;  // Au-delà: score de mat en N coups
+constexpr int BITBASE_WIN_SCORE = 20000;          // Finale gagnée selon les bitbases, mat non calculé
+
+/**
+ * @brief Limites d'une recherche
+ *
+ * La limite souple décide si une nouvelle itération est lancée; elle est allongée
+ * quand le meilleur coup change d'une itération à l'autre. La limite dure
+ * interrompt la recherche en cours d'itération.
+ */
+struct SearchLimits {
+    int depth = 4;          // Profondeur maximale en demi-coups
+    uint64_t nodes = 0;     // Nombre maximal de noeuds (0 = illimité)
+    double softTime = 0.0;  // Secondes (0 = pas de limite de temps)
+    double hardTime = 0.0;
+    int multiPV = 1;        // Variations principales cherchées (analyse), meilleure en tête
+    bool infinite = false;  // Analyse: ni coup forcé ni mat trouvé n'arrêtent l'approfondissement
+    bool ponder = false;    // Ponder: comme infinite tant que le signal de ponder est levé, puis
+                            // limites de temps comptées depuis sa retombée (ponderhit)
+
+    // Budget pour jouer un coup avec remainingSeconds à la pendule (sans incrément)
+    static SearchLimits fromClock(double remainingSeconds, int maxDepth = MAX_PLY - 1);
+};
+
+/**
+ * @brief Techniques sélectives de la recherche, activables séparément
+ *
+ * Toutes actives par défaut. Les désactiver une par une (outil Bench) mesure
+ * leur effet sur le nombre de noeuds et le coup choisi.
+ */
+struct SearchOptions {
+    bool nullMove = true;             // Coup nul (gardes anti-zugzwang)
+    bool lateMoveReductions = true;   // LMR: coups calmes tardifs réduits
+    bool futility = true;             // Coups calmes sans espoir près de l'horizon
+    bool reverseFutility = true;      // Noeud coupé si l'évaluation dépasse bêta d'une marge
+    bool principalVariation = true;   // PVS: fenêtre nulle après le premier coup
+    bool aspirationWindows = true;    // Fenêtre étroite autour du score précédent
+
+    // Table de réduction LMR: lmrBase + ln(profondeur)·ln(rang du coup) / lmrDivisor
+    double lmrBase = 0.75;
+    double lmrDivisor = 2.25;
+};
+
+/**
+ * @brief Une variation principale et son score
+ */
+struct SearchLine {
+    int score = 0;
+    std::vector<PackedMove> pv;
+
+    std::string pvString() const;
+};
+
+/**
+ * @brief Résultat d'une recherche: coup, score et statistiques
+ */
+struct SearchResult {
+    PackedMove bestMove;
+    int score = 0;
+    int depth = 0;                      // Dernière itération terminée (pas celle interrompue)
+    int selDepth = 0;                   // Ply le plus profond atteint, quiescence comprise
+    uint64_t nodes = 0;
+    double seconds = 0.0;
+    bool aborted = false;               // Dernière itération interrompue (noeuds ou temps)
+    std::vector<PackedMove> pv;         // Variation principale, bestMove en tête
+    std::vector<SearchLine> lines;      // MultiPV: meilleures variations, lines[0] = score et pv
+    TTStatistics tt;                    // Utilisation de la table de transposition
+    int hashfull = 0;                   // Remplissage de la table (pour mille)
+
+    uint64_t nodesPerSecond() const {
+        return seconds > 0.0 ? static_cast<uint64_t>(nodes / seconds) : nodes;
+    }
+    std::string pvString() const;
+};
+
+// Score lisible: "+0.35", "-1.20", "mate 3", "mated 2"
+std::string scoreToString(int score);
+
+/**
+ * @brief Recherche negamax alpha-bêta sur Position::makeMove/unmakeMove
+ *
+ * Approfondissement itératif: profondeur 1, 2, ... jusqu'à la limite, le meilleur
+ * coup de l'itération précédente étant essayé en premier à la racine. Un coup
+ * forcé est joué après la première itération.
+ *
+ * Travaille sur sa propre copie de la position, avec une pile d'états fixe
+ * (aucune allocation dans l'arbre). Les nulles par règle des 50 coups et par
+ * répétition, le long de la variation ou d'une position de la partie déjà jouée
+ * (history de run), sont détectées; les mats sont notés
+ * MATE_SCORE - ply pour préférer le mat le plus court.
+ *
+ * Avec une table de transposition, ses coupures et son meilleur coup (essayé en
+ * premier) sont utilisés à chaque noeud; la table survit d'un appel à l'autre.
+ * Les coups sont rendus par étapes par MovePicker; killers, countermoves et
+ * historique sont tenus par chaque Search (donc par thread).
+ *
+ * Sélectivité (SearchOptions): coup nul, réductions des coups tardifs, futility
+ * et reverse futility hors variation principale; recherche à fenêtre nulle (PVS)
+ * après le premier coup et fenêtres d'aspiration à la racine.
+ *
+ * À l'horizon, une recherche de quiescence poursuit les prises et promotions
+ * (toutes les parades en cas d'échec) jusqu'à une position calme; les prises
+ * perdantes selon l'échange statique (Position::staticExchange) sont ignorées.
+ *
+ * Évaluation: Evaluator::evaluate, ou un réseau NNUE s'il est fourni; ses
+ * accumulateurs suivent alors chaque coup joué et déjoué dans l'arbre.
+ *
+ * Avec des bitbases, une prise qui mène à une finale couverte (4 pièces au plus)
+ * est notée sans recherche: BITBASE_WIN_SCORE - ply, 0 ou son opposé. Si la
+ * racine elle-même est couverte, seuls ses coups qui conservent le résultat sont
+ * cherchés: l'évaluation trouve le chemin, les tables garantissent le résultat.
+ *
+ * MultiPV (SearchLimits::multiPV = N): à chaque profondeur, la racine est cherchée
+ * N fois, chaque passe excluant les premiers coups des variations déjà trouvées.
+ * Les passes partagent la table de transposition et l'ordre des coups: les N - 1
+ * variations suivantes coûtent bien moins que N recherches indépendantes.
+ *
+ * Ponder (SearchLimits::ponder): la position après la réponse attendue de
+ * l'adversaire est cherchée sans limite de temps pendant qu'il réfléchit. Quand il
+ * joue ce coup, l'appelant baisse le signal de ponder: la même recherche continue,
+ * avec ses itérations déjà faites, et ses limites de temps partent de cet instant.
+ */
+class Search {
+public:
+    Search() { setOptions(SearchOptions()); }
+
+    void setOptions(const SearchOptions& options);
+    const SearchOptions& options() const { return m_options; }
+
+    // Table partagée, possédée par l'appelant, qui appelle newSearch() avant chaque coup
+    void setTranspositionTable(TranspositionTable* table) { m_table = table; }
+
+    // Signal d'arrêt partagé (autres threads, interface); lu à chaque noeud
+    void setStopSignal(const std::atomic<bool>* stop) { m_stopSignal = stop; }
+
+    // Signal de ponder (SearchLimits::ponder), baissé par l'appelant quand le coup attendu est joué
+    void setPonderSignal(const std::atomic<bool>* pondering) { m_ponderSignal = pondering; }
+
+    // Thread auxiliaire Lazy SMP (index > 0): profondeurs décalées, pas de gestion du temps
+    void setThreadIndex(int index) { m_threadIndex = index; }
+
+    // Réseau partagé, possédé par l'appelant (nullptr: évaluation classique)
+    void setNetwork(const Nnue::Network* network);
+
+    // Bitbases partagées, possédées par l'appelant (nullptr: aucun sondage)
+    void setBitbases(const EndgameBitbases* bitbases) { m_bitbases = bitbases; }
+
+    // Appelé après chaque itération terminée, sur le thread de la recherche
+    using ProgressCallback = std::function<void(const SearchResult&)>;
+    void setProgressCallback(ProgressCallback callback) { m_progressCallback = std::move(callback); }
+
+    /**
+     * @brief Recherche le meilleur coup de position
+     * @param history Clés des positions de la partie jouées avant position, la plus ancienne
+     *                en tête: une variation qui en répète une est nulle
+     */
+    SearchResult run(const Position& position, const SearchLimits& limits,
+                     const std::vector<uint64_t>& history = {});
+
+private:
+    static constexpr int MAX_REDUCTION_INDEX = 64;
+
+    SearchOptions m_options;
+    int m_reductions[MAX_REDUCTION_INDEX][MAX_REDUCTION_INDEX] = {};  // [profondeur][rang du coup]
+    bool m_nullMoveAllowed = true;  // Faux pendant la recherche de vérification du coup nul
+
+    TranspositionTable* m_table = nullptr;
+    TTStatistics m_ttStats;
+    const std::atomic<bool>* m_stopSignal = nullptr;
+    const std::atomic<bool>* m_ponderSignal = nullptr;
+    int m_threadIndex = 0;
+    ProgressCallback m_progressCallback;
+
+    Position m_position;
+    StateInfo m_states[MAX_PLY];
+    uint64_t m_keys[MAX_PLY + 1];            // Clé de chaque position de la variation courante
+    std::vector<uint64_t> m_gameKeys;        // Partie avant la racine, depuis le dernier coup irréversible
+    PackedMove m_pv[MAX_PLY + 1][MAX_PLY + 1]; // Table triangulaire des variations principales
+    int m_pvLength[MAX_PLY + 1];
+    PackedMove m_moves[MAX_PLY];             // Coup joué à chaque ply de la variation courante
+
+    // Ordre des coups calmes, appris pendant la recherche
+    PackedMove m_killers[MAX_PLY][2];        // Derniers coups calmes ayant coupé, par ply
+    PackedMove m_counterMoves[NO_PIECE + 1][SQUARE_COUNT]; // Réfutation par [pièce][arrivée] du coup précédent
+    ButterflyHistory m_history;
+    PawnHashTable m_pawnTable;               // Structure de pions évaluée, propre au thread
+    const Nnue::Network* m_network = nullptr;
+    Nnue::AccumulatorStack m_accumulators;   // Utilisés seulement avec un réseau
+    const EndgameBitbases* m_bitbases = nullptr;
+    MoveList m_rootMoves;                    // Coups cherchés à la racine
+    MoveList m_excludedRootMoves;            // MultiPV: premiers coups des variations déjà trouvées
+    int m_rootPieceCount = 0;
+
+    uint64_t m_nodes = 0;
+    uint64_t m_nodeLimit = 0;
+    double m_hardTime = 0.0;
+    std::chrono::steady_clock::time_point m_startTime;
+    std::chrono::steady_clock::time_point m_clockStart;  // Départ des limites de temps (ponderhit)
+    bool m_pondering = false;
+    PackedMove m_rootMove;  // Coup essayé en premier à la racine (itération précédente)
+    int m_selDepth = 0;
+    bool m_stopped = false;
+
+    int aspirationSearch(int depth, int previousScore);
+    int negamax(int depth, int ply, int alpha, int beta);
+    int quiescence(int ply, int alpha, int beta);
+    int evaluate();
+    // Score exact d'une finale des bitbases atteinte par une prise
+    bool probeBitbases(int ply, int& score);
+    // Racine couverte par les bitbases: retire les coups qui gâchent le résultat
+    void filterRootMoves();
+    // makeMove/unmakeMove avec la variation courante (coups, clés, accumulateurs)
+    void doMove(int ply, PackedMove move);
+    void undoMove(int ply, PackedMove move);
+    void doNullMove(int ply);
+    void undoNullMove(int ply);
+    void checkLimits();
+    void checkPonderHit();
+    bool skipsDepth(int depth) const;
+    double elapsedSeconds() const;
+    double clockSeconds() const;  // Temps compté par les limites
+    bool isDraw(int ply) const;
+    void updateQuietStats(int ply, int depth, PackedMove move, const PackedMove* quietsTried, int quietCount);
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "PackedMove.h"
+
+// Nature du score stocké par rapport à la fenêtre alpha-bêta de la recherche
+enum class Bound : uint8_t {
+    None,
+    Upper,  // Score <= valeur (aucun coup n'a dépassé alpha)
+    Lower,  // Score >= valeur (coupure bêta)
+    Exact
+};
+
+/**
+ * @brief Contenu décodé d'une entrée de la table
+ */
+struct TTEntry {
+    PackedMove move;
+    int16_t score = 0;
+    uint8_t depth = 0;
+    Bound bound = Bound::None;
+};
+
+/**
+ * @brief Compteurs d'utilisation, tenus par chaque thread de recherche
+ *
+ * Les garder hors de la table évite que tous les threads écrivent la même
+ * ligne de cache à chaque sonde.
+ */
+struct TTStatistics {
+    uint64_t probes = 0;
+    uint64_t hits = 0;
+    uint64_t stores = 0;
+    uint64_t collisions = 0;  // Entrées vivantes d'une autre position écrasées
+
+    double hitRate() const { return probes ? static_cast<double>(hits) / probes : 0.0; }
+    TTStatistics& operator+=(const TTStatistics& other);
+};
+
+/**
+ * @brief Table de transposition partagée, sans verrou
+ *
+ * Taille fixe (puissance de deux de buckets de 64 octets, une ligne de cache),
+ * indexée par la clé Zobrist. Chaque bucket contient 4 entrées de deux mots:
+ * `data` et `key ^ data`. Une écriture concurrente qui mélange les deux mots
+ * d'entrées différentes donne une clé incohérente et l'entrée est simplement
+ * ignorée: plusieurs threads partagent la table sans mutex.
+ *
+ * Remplacement: même position, sinon entrée vide, sinon la moins utile
+ * (faible profondeur et ancienne génération).
+ */
+class TranspositionTable {
+public:
+    static constexpr size_t DEFAULT_SIZE_MB = 16;
+
+    explicit TranspositionTable(size_t megabytes = DEFAULT_SIZE_MB);
+
+    // Réalloue la table (contenu perdu); à n'appeler qu'en dehors d'une recherche
+    void resize(size_t megabytes);
+    void clear();
+
+    // Nouvelle recherche: les entrées des recherches précédentes vieillissent
+    void newSearch() { m_generation = (m_generation + 1) & GENERATION_MASK; }
+
+    bool probe(uint64_t key, TTEntry& entry, TTStatistics& stats) const;
+    void store(uint64_t key, PackedMove move, int score, int depth, Bound bound, TTStatistics& stats);
+
+    // Remplissage en pour mille, estimé sur les premiers buckets (entrées de la recherche courante)
+    int hashfull() const;
+    size_t sizeMB() const { return m_bucketCount * sizeof(Bucket) / (1024 * 1024); }
+
+private:
+    static constexpr int ENTRIES_PER_BUCKET = 4;
+    static constexpr uint8_t GENERATION_MASK = 0x3F;  // 6 bits, à côté des 2 bits de Bound
+
+    struct Slot {
+        std::atomic<uint64_t> keyXorData{ 0 };
+        std::atomic<uint64_t> data{ 0 };
+    };
+
+    struct alignas(64) Bucket {
+        Slot slots[ENTRIES_PER_BUCKET];
+    };
+
+    std::unique_ptr<Bucket[]> m_buckets;
+    size_t m_bucketCount = 0;
+    uint8_t m_generation = 0;
+
+    Bucket& bucketFor(uint64_t key) const { return m_buckets[key & (m_bucketCount - 1)]; }
+};
@@ -1,37 +1,26 @@
 #include "PieceView.h"
 #include "Entities/ChessPiece.h"
+#include <algorithm>
 
-PieceView::PieceView(ChessPiece* piece) : m_piece(piece) {}
+PieceView::PieceView(const ChessPiece* piece) : m_piece(piece) {}
 
-void PieceView::setPiece(ChessPiece* p) { m_piece = p; }
+void PieceView::setPiece(const ChessPiece* p) { m_piece = p; }
 
-std::string PieceView::texturePathForPiece() const {
-    if (!m_piece || m_piece->type.empty()) return "";
-    const std::string& t = m_piece->type;
-    const bool white = (m_piece->color == "white");
-    std::string base = white ? "assets/white_" : "assets/black_";
-    if (t == "pawn") return base + "pawn.png";
-    if (t == "knight") return base + "knight.png";
-    if (t == "bishop") return base + "bishop.png";
-    if (t == "rook") return base + "rook.png";
-    if (t == "queen") return base + "queen.png";
-    if (t == "king") return base + "king.png";
-    return "";
-}
+void PieceView::setTexture(const sf::Texture& texture, float squareSize) {
+    m_sprite.setTexture(texture, true);
+
+    float scale = squareSize / std::max(texture.getSize().x, texture.getSize().y) * 0.8f;
+    m_sprite.setScale(scale, scale);
 
-void PieceView::loadTextureFromPiece() {
-    const std::string path = texturePathForPiece();
-    if (path.empty()) return;
-    if (m_texture.loadFromFile(path)) {
-        m_sprite.setTexture(m_texture);
-    }
+    sf::FloatRect bounds = m_sprite.getLocalBounds();
+    m_sprite.setOrigin(bounds.width / 2, bounds.height / 2);
 }
 
-void PieceView::updatePosition(int boardX, int boardY) {
-    const float tileSize = 64.0f; // placeholder
-    m_sprite.setPosition(boardX * tileSize, boardY * tileSize);
+void PieceView::setCenter(float x, float y) {
+    m_sprite.setPosition(x, y);
 }
 
-void PieceView::draw(sf::RenderWindow& window) {
+void PieceView::draw(sf::RenderWindow& window) const {
+    if (!m_piece || m_piece->type.empty() || !m_sprite.getTexture()) return;
     window.draw(m_sprite);
 }
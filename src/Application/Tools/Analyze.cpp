@@ -0,0 +1,103 @@
+// Analyze: analyse MultiPV d'une position en ligne de commande, avec le moteur du
+// niveau Difficile (AIEngine::startAnalysis). Chaque itération terminée est affichée
+// dès qu'elle est publiée, une ligne par variation, au format "info" de l'UCI.
+//
+// L'analyse s'arrête après --time secondes (10 par défaut sans --depth), ou dès que
+// la profondeur --depth est terminée.
+//
+// Usage:
+//   Analyze [--fen "<fen>"] [--multipv N] [--depth N] [--time S] [--threads N] [--hash MB]
+
+#include "AIEngine.h"
+#include "Entities/Position.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+    const char* const START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+    const int DEFAULT_LINES = 3;
+    const double DEFAULT_SECONDS = 10.0;
+
+    // "+0.35" -> "cp 35", "mate 3" -> "mate 3", "mated 2" -> "mate -2"
+    std::string uciScore(const std::string& score) {
+        if (score.rfind("mated ", 0) == 0) return "mate -" + score.substr(6);
+        if (score.rfind("mate ", 0) == 0) return score;
+        double pawns = std::atof(score.c_str());
+        return "cp " + std::to_string(static_cast<int>(pawns * 100.0 + (pawns < 0.0 ? -0.5 : 0.5)));
+    }
+
+    void printProgress(const SearchProgress& progress) {
+        for (size_t i = 0; i < progress.lines.size(); i++) {
+            std::cout << "info depth " << progress.depth << " seldepth " << progress.selDepth
+                      << " multipv " << i + 1 << " score " << uciScore(progress.lines[i].score)
+                      << " nodes " << progress.nodes << " nps " << progress.nodesPerSecond
+                      << " time " << static_cast<int>(progress.seconds * 1000)
+                      << " pv " << progress.lines[i].pv << std::endl;
+        }
+    }
+
+    void usage() {
+        std::cout << "Usage: Analyze [--fen \"<fen>\"] [--multipv N] [--depth N] [--time S] [--threads N] [--hash MB]"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string fen = START_FEN;
+    int lineCount = DEFAULT_LINES;
+    int maxDepth = 0;
+    double seconds = -1.0;
+    int threadCount = 1;
+    int hashMB = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--fen" && i + 1 < argc) fen = argv[++i];
+        else if (arg == "--multipv" && i + 1 < argc) lineCount = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--depth" && i + 1 < argc) maxDepth = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--time" && i + 1 < argc) seconds = std::max(0.0, std::atof(argv[++i]));
+        else if (arg == "--threads" && i + 1 < argc) threadCount = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--hash" && i + 1 < argc) hashMB = std::max(1, std::atoi(argv[++i]));
+        else {
+            usage();
+            return 1;
+        }
+    }
+    if (seconds < 0.0) seconds = maxDepth > 0 ? 0.0 : DEFAULT_SECONDS;
+
+    Position position;
+    if (!position.setFromFen(fen)) {
+        std::cout << "[Analyze] Invalid FEN: " << fen << std::endl;
+        return 1;
+    }
+
+    std::unique_ptr<AIEngine> engine = createAIEngine(3);
+    engine->setThreadCount(threadCount);
+    if (hashMB > 0) engine->setHashSize(hashMB);
+
+    // Sortie en continu; la profondeur demandée terminée, le listener arrête l'analyse
+    AIEngine* analyzer = engine.get();
+    engine->setProgressListener([analyzer, maxDepth](const SearchProgress& progress) {
+        printProgress(progress);
+        if (maxDepth > 0 && progress.depth >= maxDepth) analyzer->stopSearch();
+    });
+
+    std::future<SearchProgress> analysis = engine->startAnalysis(position, lineCount);
+    if (seconds > 0.0
+        && analysis.wait_for(std::chrono::duration<double>(seconds)) != std::future_status::ready) {
+        engine->stopSearch();
+    }
+    SearchProgress result = analysis.get();
+
+    if (result.lines.empty()) {
+        std::cout << "[Analyze] No legal moves" << std::endl;
+        return 0;
+    }
+    std::cout << "bestmove " << result.pv.substr(0, result.pv.find(' ')) << std::endl;
+    return 0;
+}
@@ -0,0 +1,202 @@
+// Bench: mesure la recherche (ParallelSearch) à profondeur fixe sur des positions de
+// référence, pour 1, 2, 4 ... N threads. Rapporte le temps pour atteindre la profondeur
+// et le débit en noeuds/s, ainsi que leur rapport à la recherche sur un seul thread.
+//
+// Avec --selectivity, compare sur un thread la recherche complète à la recherche privée
+// de chaque technique sélective, une à la fois: noeuds, temps et coups qui changent.
+//
+// Avec --nnue, la recherche évalue avec ce réseau; --kernels impose un jeu d'instructions
+// (scalar, sse41, avx2) pour comparer les noyaux: mêmes noeuds, débit différent.
+//
+// Usage:
+//   Bench [depth] [--threads N] [--hash MB] [--fen "<fen>"] [--off <feature>]... [--selectivity]
+//         [--nnue <file>] [--kernels <scalar|sse41|avx2>]
+//   features: null, lmr, futility, rfp, pvs, aspiration
+
+#include "Entities/Position.h"
+#include "Nnue.h"
+#include "ParallelSearch.h"
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    const std::vector<std::string> BENCH_POSITIONS = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP3PPP/R2QKB1R w KQ - 0 8",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "6k1/pp3pp1/2p4p/8/3P4/2P1r1P1/PP3K1P/4R3 b - - 0 30"
+    };
+
+    struct BenchRun {
+        int threads = 1;
+        double seconds = 0.0;
+        uint64_t nodes = 0;
+        std::vector<PackedMove> bestMoves;
+
+        double nps() const { return seconds > 0.0 ? nodes / seconds : 0.0; }
+    };
+
+    // Nom en ligne de commande -> interrupteur de SearchOptions
+    struct Feature {
+        const char* name;
+        bool SearchOptions::* flag;
+    };
+
+    const Feature FEATURES[] = {
+        { "null", &SearchOptions::nullMove },
+        { "lmr", &SearchOptions::lateMoveReductions },
+        { "futility", &SearchOptions::futility },
+        { "rfp", &SearchOptions::reverseFutility },
+        { "pvs", &SearchOptions::principalVariation },
+        { "aspiration", &SearchOptions::aspirationWindows }
+    };
+
+    const Feature* findFeature(const std::string& name) {
+        for (const Feature& feature : FEATURES) {
+            if (name == feature.name) return &feature;
+        }
+        return nullptr;
+    }
+
+    BenchRun runBench(const std::vector<Position>& positions, int depth, int threadCount,
+                      TranspositionTable& table, const SearchOptions& options, const Nnue::Network* network) {
+        ParallelSearch search(table, threadCount);
+        search.setOptions(options);
+        search.setNetwork(network);
+        SearchLimits limits;
+        limits.depth = depth;
+
+        BenchRun run;
+        run.threads = threadCount;
+        for (const Position& position : positions) {
+            // Table vide pour chaque position: le temps mesuré est bien un temps jusqu'à la profondeur
+            table.clear();
+            SearchResult result = search.run(position, limits);
+            run.seconds += result.seconds;
+            run.nodes += result.nodes;
+            run.bestMoves.push_back(result.bestMove);
+        }
+        return run;
+    }
+
+    void runSelectivity(const std::vector<Position>& positions, int depth, TranspositionTable& table,
+                        const SearchOptions& options, const Nnue::Network* network) {
+        std::cout << std::setw(12) << "disabled" << std::setw(12) << "time (s)" << std::setw(14) << "nodes"
+                  << std::setw(12) << "nodes x" << std::setw(16) << "moves changed" << std::endl;
+
+        BenchRun reference = runBench(positions, depth, 1, table, options, network);
+        auto report = [&](const char* name, const BenchRun& run) {
+            int changed = 0;
+            for (size_t i = 0; i < run.bestMoves.size(); i++) {
+                if (run.bestMoves[i] != reference.bestMoves[i]) changed++;
+            }
+            std::cout << std::fixed << std::setprecision(3)
+                      << std::setw(12) << name << std::setw(12) << run.seconds << std::setw(14) << run.nodes
+                      << std::setprecision(2)
+                      << std::setw(11) << (reference.nodes ? static_cast<double>(run.nodes) / reference.nodes : 0.0)
+                      << "x" << std::setw(16) << changed << std::endl;
+        };
+
+        report("none", reference);
+        for (const Feature& feature : FEATURES) {
+            if (!(options.*feature.flag)) continue;
+            SearchOptions without = options;
+            without.*feature.flag = false;
+            report(feature.name, runBench(positions, depth, 1, table, without, network));
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int depth = 7;
+    int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t hashMB = TranspositionTable::DEFAULT_SIZE_MB;
+    std::string fen;
+    SearchOptions options;
+    bool selectivity = false;
+    std::string evalFile;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const Feature* feature = nullptr;
+        if (arg == "--threads" && i + 1 < argc) maxThreads = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--hash" && i + 1 < argc) hashMB = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--fen" && i + 1 < argc) fen = argv[++i];
+        else if (arg == "--off" && i + 1 < argc && (feature = findFeature(argv[i + 1]))) {
+            options.*feature->flag = false;
+            i++;
+        }
+        else if (arg == "--selectivity") selectivity = true;
+        else if (arg == "--nnue" && i + 1 < argc) evalFile = argv[++i];
+        else if (arg == "--kernels" && i + 1 < argc) {
+            std::string name = argv[++i];
+            Nnue::setBackend(name == "avx2" ? Nnue::Backend::Avx2
+                             : name == "sse41" ? Nnue::Backend::Sse41 : Nnue::Backend::Scalar);
+        }
+        else if (std::atoi(arg.c_str()) > 0) depth = std::atoi(arg.c_str());
+        else {
+            std::cout << "Usage: Bench [depth] [--threads N] [--hash MB] [--fen \"<fen>\"] [--off <feature>]..."
+                      << " [--selectivity] [--nnue <file>] [--kernels <scalar|sse41|avx2>]" << std::endl;
+            std::cout << "  features: null, lmr, futility, rfp, pvs, aspiration" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<Position> positions;
+    for (const std::string& text : fen.empty() ? BENCH_POSITIONS : std::vector<std::string>{ fen }) {
+        Position position;
+        if (!position.setFromFen(text)) {
+            std::cout << "[Bench] Invalid FEN: " << text << std::endl;
+            return 1;
+        }
+        positions.push_back(position);
+    }
+
+    // 1, 2, 4 ... threads, puis le maximum demandé s'il n'est pas une puissance de deux
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    Nnue::Network network;
+    if (!evalFile.empty() && !network.load(evalFile)) return 1;
+    const Nnue::Network* evaluator = network.isLoaded() ? &network : nullptr;
+
+    TranspositionTable table(hashMB);
+    std::cout << "[Bench] " << positions.size() << " position(s), depth " << depth << ", evaluation: "
+              << (evaluator ? std::string("NNUE, ") + Nnue::backendName(Nnue::activeBackend()) + " kernels"
+                            : std::string("hand-crafted")) << std::endl;
+
+    if (selectivity) {
+        runSelectivity(positions, depth, table, options, evaluator);
+        return 0;
+    }
+
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "time (s)" << std::setw(14) << "nodes"
+              << std::setw(14) << "nps" << std::setw(16) << "time-to-depth" << std::setw(12) << "nps x"
+              << std::endl;
+
+    BenchRun single;
+    for (int threads : threadCounts) {
+        BenchRun run = runBench(positions, depth, threads, table, options, evaluator);
+        if (threads == 1) single = run;
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << std::setw(8) << run.threads << std::setw(12) << run.seconds
+                  << std::setw(14) << run.nodes << std::setw(14) << static_cast<uint64_t>(run.nps())
+                  << std::setprecision(2)
+                  << std::setw(15) << (run.seconds > 0.0 ? single.seconds / run.seconds : 0.0) << "x"
+                  << std::setw(11) << (single.nps() > 0.0 ? run.nps() / single.nps() : 0.0) << "x"
+                  << std::endl;
+    }
+    return 0;
+}
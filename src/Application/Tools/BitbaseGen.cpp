@@ -0,0 +1,125 @@
+// BitbaseGen: génère les bitbases de finales à 3 et 4 pièces par analyse rétrograde.
+//
+// Sans matériel en argument, toutes les finales à 3 et 4 pièces sont générées
+// (les nulles triviales KK, KNK et KBK n'ont pas de table). Les tables déjà
+// présentes dans le dossier de sortie sont relues au lieu d'être recalculées,
+// y compris celles dont dépend une table demandée.
+//
+// Avec --probe, affiche le résultat d'une position et de chacun de ses coups.
+//
+// Usage:
+//   BitbaseGen [KQKR KPK ...] [-o <dossier>] [--threads N]
+//   BitbaseGen --probe <dossier> --fen "<fen>"
+
+#include "EndgameBitbases.h"
+#include "MoveGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    const char* const DEFAULT_DIRECTORY = "assets/bitbases";
+
+    const char* wdlName(Wdl result) {
+        switch (result) {
+            case Wdl::Win: return "win";
+            case Wdl::Loss: return "loss";
+            default: return "draw";
+        }
+    }
+
+    int probe(const std::string& directory, const std::string& fen) {
+        EndgameBitbases bitbases;
+        bitbases.open(directory);
+        Position position;
+        if (fen.empty() || !position.setFromFen(fen)) {
+            std::cout << "[BitbaseGen] Invalid FEN: " << fen << std::endl;
+            return 1;
+        }
+
+        Wdl result;
+        if (!bitbases.probe(position, result)) {
+            std::cout << "[BitbaseGen] Position not covered by the bitbases" << std::endl;
+            return 1;
+        }
+
+        // Premier sondage: chargement de la table; ensuite seulement le coût d'une lecture
+        const int repetitions = 100000;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; i++) bitbases.probe(position, result);
+        double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+                     / repetitions;
+        std::cout << "[BitbaseGen] " << toString(position.sideToMove()) << " to move: " << wdlName(result)
+                  << " (probe " << std::fixed << std::setprecision(0) << nanos << " ns)" << std::endl;
+
+        // Résultat de chaque coup, du point de vue du camp qui le joue
+        MoveList moves;
+        MoveGenerator(position).generateLegalMoves(position.sideToMove(), moves);
+        for (int i = 0; i < moves.size(); i++) {
+            StateInfo state;
+            Wdl child;
+            position.makeMove(moves[i], state);
+            bool known = bitbases.probe(position, child);
+            position.unmakeMove(moves[i], state);
+            std::cout << "  " << std::setw(6) << toUciString(moves[i]) << "  "
+                      << (known ? wdlName(static_cast<Wdl>(-static_cast<int>(child))) : "?") << std::endl;
+        }
+        return 0;
+    }
+
+    void usage() {
+        std::cout << "Usage: BitbaseGen [KQKR KPK ...] [-o <directory>] [--threads N]" << std::endl;
+        std::cout << "       BitbaseGen --probe <directory> --fen \"<fen>\"" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> materials;
+    std::string output = DEFAULT_DIRECTORY;
+    std::string probePath;
+    std::string fen;
+    int threadCount = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) output = argv[++i];
+        else if (arg == "--threads" && i + 1 < argc) threadCount = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--probe" && i + 1 < argc) probePath = argv[++i];
+        else if (arg == "--fen" && i + 1 < argc) fen = argv[++i];
+        else if (!arg.empty() && arg[0] != '-' && !EndgameBitbases::normalize(arg).empty()) materials.push_back(arg);
+        else {
+            usage();
+            return 1;
+        }
+    }
+
+    if (!probePath.empty()) return probe(probePath, fen);
+    if (materials.empty()) materials = EndgameBitbases::allMaterials();
+
+    // Tables existantes: reprises telles quelles, et servent de dépendances
+    EndgameBitbases bitbases;
+    bitbases.open(output);
+    std::vector<std::string> existing = bitbases.materials();
+
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string& material : materials) {
+        if (!bitbases.generate(material, threadCount)) return 1;
+    }
+
+    int written = 0;
+    for (const std::string& material : bitbases.materials()) {
+        if (std::find(existing.begin(), existing.end(), material) != existing.end()) continue;
+        if (!bitbases.save(material, output)) return 1;
+        written++;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[BitbaseGen] " << written << " table(s) written to " << output << " in " << std::fixed
+              << std::setprecision(1) << seconds << " s" << std::endl;
+    return 0;
+}
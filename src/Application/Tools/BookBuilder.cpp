@@ -0,0 +1,394 @@
+// BookBuilder: compile un livre d'ouvertures Polyglot (.bin) à partir de parties PGN.
+//
+// Chaque coup joué dans les premiers demi-coups d'une partie devient une entrée
+// (position, coup). Poids à la Polyglot, du point de vue du camp qui joue le coup:
+// 2 par victoire, 1 par nulle, 0 par défaite; mis à l'échelle sur 16 bits. Les coups
+// joués dans moins de --min-games parties, ou jamais par le camp qui n'a pas perdu,
+// sont écartés.
+//
+// Avec --probe, affiche les coups du livre pour une position et le temps d'une recherche.
+// Avec --check, compare les clés calculées aux clés de référence de Polyglot.
+//
+// Usage:
+//   BookBuilder <games.pgn>... -o <book.bin> [--plies N] [--min-games N]
+//   BookBuilder --probe <book.bin> [--fen "<fen>"]
+//   BookBuilder --check
+
+#include "Entities/Position.h"
+#include "MoveGenerator.h"
+#include "OpeningBook.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    const std::string START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+    // Résultats des parties où le coup a été joué, vus du camp qui le joue
+    struct MoveStats {
+        uint32_t wins = 0;
+        uint32_t draws = 0;
+        uint32_t losses = 0;
+
+        uint32_t games() const { return wins + draws + losses; }
+        uint64_t weight() const { return 2ull * wins + draws; }
+    };
+
+    struct BuildOptions {
+        int maxPlies = 20;
+        uint32_t minGames = 2;
+    };
+
+    struct GameStats {
+        uint64_t games = 0;
+        uint64_t skipped = 0;  // Coup illisible ou illégal: la suite de la partie est ignorée
+    };
+
+    using BookStats = std::map<std::pair<uint64_t, uint16_t>, MoveStats>;
+
+    PieceType pieceFromLetter(char letter) {
+        switch (letter) {
+            case 'N': return PieceType::Knight;
+            case 'B': return PieceType::Bishop;
+            case 'R': return PieceType::Rook;
+            case 'Q': return PieceType::Queen;
+            case 'K': return PieceType::King;
+            default: return PieceType::None;
+        }
+    }
+
+    // Coup légal désigné par un coup en notation algébrique (SAN), PackedMove() sinon
+    PackedMove parseSan(const Position& position, std::string san) {
+        while (!san.empty() && std::string("+#!?").find(san.back()) != std::string::npos) san.pop_back();
+
+        MoveList moves;
+        MoveGenerator(position).generateLegalMoves(position.sideToMove(), moves);
+
+        if (san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0") {
+            int kingFile = san.size() == 3 ? 6 : 2;
+            for (int i = 0; i < moves.size(); i++) {
+                if (moves[i].flag() == CASTLING_MOVE && fileOf(moves[i].to()) == kingFile) return moves[i];
+            }
+            return PackedMove();
+        }
+
+        // Promotion: "e8=Q" ou "e8Q"
+        PieceType promotion = PieceType::None;
+        if (san.size() >= 2 && pieceFromLetter(san.back()) != PieceType::None && san.back() != 'K') {
+            promotion = pieceFromLetter(san.back());
+            san.pop_back();
+            if (!san.empty() && san.back() == '=') san.pop_back();
+        }
+
+        PieceType type = PieceType::Pawn;
+        if (!san.empty() && pieceFromLetter(san[0]) != PieceType::None) {
+            type = pieceFromLetter(san[0]);
+            san.erase(0, 1);
+        }
+        san.erase(std::remove(san.begin(), san.end(), 'x'), san.end());
+        if (san.size() < 2) return PackedMove();
+
+        int toFile = san[san.size() - 2] - 'a';
+        int toRank = san[san.size() - 1] - '1';
+        if (toFile < 0 || toFile > 7 || toRank < 0 || toRank > 7) return PackedMove();
+        int to = toRank * 8 + toFile;
+
+        // Désambiguïsation: colonne et/ou rangée de départ
+        int fromFile = -1;
+        int fromRank = -1;
+        for (char c : san.substr(0, san.size() - 2)) {
+            if (c >= 'a' && c <= 'h') fromFile = c - 'a';
+            else if (c >= '1' && c <= '8') fromRank = c - '1';
+            else return PackedMove();
+        }
+
+        PackedMove found;
+        for (int i = 0; i < moves.size(); i++) {
+            PackedMove move = moves[i];
+            if (move.to() != to || move.flag() == CASTLING_MOVE) continue;
+            if (typeOf(position.pieceOn(move.from())) != type) continue;
+            if (fromFile >= 0 && fileOf(move.from()) != fromFile) continue;
+            if (fromRank >= 0 && rankOf(move.from()) != fromRank) continue;
+            if (move.promotionType() != promotion) continue;
+            if (!found.isNull()) return PackedMove();  // Ambigu
+            found = move;
+        }
+        return found;
+    }
+
+    // Résultat blanc: 1 victoire, 0 nulle, -1 défaite; 2 = inconnu ("*")
+    int parseResult(const std::string& token) {
+        if (token == "1-0") return 1;
+        if (token == "0-1") return -1;
+        if (token == "1/2-1/2") return 0;
+        return 2;
+    }
+
+    void addGame(const std::vector<std::pair<uint64_t, PackedMove>>& moves, Color firstMover, int whiteResult,
+                 BookStats& stats) {
+        if (whiteResult == 2) return;
+        Color mover = firstMover;
+        for (const auto& [key, move] : moves) {
+            int result = mover == Color::White ? whiteResult : -whiteResult;
+            MoveStats& entry = stats[{ key, OpeningBook::encodeMove(move) }];
+            if (result > 0) entry.wins++;
+            else if (result == 0) entry.draws++;
+            else entry.losses++;
+            mover = opposite(mover);
+        }
+    }
+
+    // Lecture d'un fichier PGN: en-têtes, commentaires, variantes et NAG sont ignorés
+    void readPgn(std::istream& input, const BuildOptions& options, BookStats& stats, GameStats& gameStats) {
+        std::string text((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+        Position position;
+        position.setFromFen(START_FEN);
+        std::vector<std::pair<uint64_t, PackedMove>> moves;
+        Color firstMover = Color::White;
+        bool inGame = false;
+        bool broken = false;
+        int ply = 0;
+
+        auto finishGame = [&](int whiteResult) {
+            if (inGame || !moves.empty()) {
+                addGame(moves, firstMover, whiteResult, stats);
+                gameStats.games++;
+                if (broken) gameStats.skipped++;
+            }
+            position.setFromFen(START_FEN);
+            moves.clear();
+            firstMover = Color::White;
+            inGame = false;
+            broken = false;
+            ply = 0;
+        };
+
+        size_t i = 0;
+        while (i < text.size()) {
+            char c = text[i];
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                i++;
+            } else if (c == '[') {
+                // En-tête; une partie commencée sans résultat lisible se termine ici
+                size_t end = text.find(']', i);
+                std::string tag = text.substr(i + 1, end == std::string::npos ? std::string::npos : end - i - 1);
+                if (inGame) finishGame(2);
+                if (tag.rfind("FEN ", 0) == 0) {
+                    size_t open = tag.find('"');
+                    size_t close = tag.rfind('"');
+                    if (open != std::string::npos && close > open
+                        && position.setFromFen(tag.substr(open + 1, close - open - 1))) {
+                        firstMover = position.sideToMove();
+                    } else {
+                        broken = true;
+                    }
+                }
+                i = end == std::string::npos ? text.size() : end + 1;
+            } else if (c == '{') {
+                size_t end = text.find('}', i);
+                i = end == std::string::npos ? text.size() : end + 1;
+            } else if (c == ';' || c == '%') {
+                size_t end = text.find('\n', i);
+                i = end == std::string::npos ? text.size() : end + 1;
+            } else if (c == '(') {
+                int depth = 0;
+                do {
+                    if (text[i] == '(') depth++;
+                    else if (text[i] == ')') depth--;
+                    else if (text[i] == '{') i = std::min(text.find('}', i), text.size() - 1);
+                    i++;
+                } while (i < text.size() && depth > 0);
+            } else {
+                size_t end = i;
+                while (end < text.size() && !std::isspace(static_cast<unsigned char>(text[end]))
+                       && text[end] != '{' && text[end] != '(' && text[end] != ';') {
+                    end++;
+                }
+                std::string token = text.substr(i, end - i);
+                i = end;
+
+                int result = parseResult(token);
+                if (result != 2 || token == "*") {
+                    finishGame(result);
+                    continue;
+                }
+                if (token[0] == '$') continue;
+
+                // Numéro de coup, éventuellement collé au coup: "12.", "12...", "12.e4"
+                size_t start = 0;
+                while (start < token.size() && std::isdigit(static_cast<unsigned char>(token[start]))) start++;
+                if (start > 0 && start < token.size() && token[start] == '.') {
+                    while (start < token.size() && token[start] == '.') start++;
+                    token = token.substr(start);
+                } else if (start == token.size()) {
+                    continue;
+                }
+                if (token.empty()) continue;
+
+                inGame = true;
+                if (broken || ply >= options.maxPlies) continue;
+                PackedMove move = parseSan(position, token);
+                if (move.isNull()) {
+                    broken = true;
+                    continue;
+                }
+                moves.push_back({ OpeningBook::hashKey(position), move });
+                StateInfo state;
+                position.makeMove(move, state);
+                ply++;
+            }
+        }
+        if (inGame) finishGame(2);
+    }
+
+    std::vector<OpeningBook::Entry> makeEntries(const BookStats& stats, const BuildOptions& options) {
+        std::vector<OpeningBook::Entry> entries;
+        uint64_t maxWeight = 1;
+        for (const auto& [keyMove, moveStats] : stats) {
+            if (moveStats.games() >= options.minGames) maxWeight = std::max(maxWeight, moveStats.weight());
+        }
+
+        // Poids ramenés sur 16 bits si nécessaire, sans qu'un coup retenu tombe à 0
+        double scale = maxWeight > 0xFFFF ? static_cast<double>(0xFFFF) / maxWeight : 1.0;
+        for (const auto& [keyMove, moveStats] : stats) {
+            if (moveStats.games() < options.minGames || moveStats.weight() == 0) continue;
+            OpeningBook::Entry entry;
+            entry.key = keyMove.first;
+            entry.move = keyMove.second;
+            entry.weight = static_cast<uint16_t>(std::max(1.0, moveStats.weight() * scale));
+            entries.push_back(entry);
+        }
+        return entries;
+    }
+
+    int probe(const std::string& path, const std::string& fen) {
+        OpeningBook book;
+        if (!book.open(path)) return 1;
+        Position position;
+        if (!position.setFromFen(fen)) {
+            std::cout << "[BookBuilder] Invalid FEN: " << fen << std::endl;
+            return 1;
+        }
+
+        const int repetitions = 10000;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<BookMove> moves;
+        for (int i = 0; i < repetitions; i++) moves = book.probe(position);
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count()
+                      / repetitions;
+
+        uint64_t total = 0;
+        for (const BookMove& move : moves) total += move.weight;
+        std::cout << "[BookBuilder] " << moves.size() << " book move(s), lookup " << std::fixed
+                  << std::setprecision(2) << micros << " us" << std::endl;
+        for (const BookMove& move : moves) {
+            std::cout << "  " << std::setw(6) << toUciString(move.move) << std::setw(8) << move.weight
+                      << std::setw(8) << std::setprecision(1) << (total ? 100.0 * move.weight / total : 0.0) << "%"
+                      << std::endl;
+        }
+        return 0;
+    }
+
+    // Clés de référence du format Polyglot (partie 1.e4 d5 2.e5 f5 3.Ke2 Kf7, puis
+    // 1.a4 b5 2.h4 b4 3.c4 bxc3 4.Ra3): un écart signale une table RANDOM_64 fausse
+    struct KnownKey {
+        const char* fen;
+        uint64_t key;
+    };
+
+    const KnownKey KNOWN_KEYS[] = {
+        { "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 0x463B96181691FC9CULL },
+        { "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1", 0x823C9B50FD114196ULL },
+        { "rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2", 0x0756B94461C50FB0ULL },
+        { "rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2", 0x662FAFB965DB29D4ULL },
+        { "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3", 0x22A48B5A8E47FF78ULL },
+        { "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3", 0x652A607CA3F242C1ULL },
+        { "rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4", 0x00FDD303C946BDD9ULL },
+        { "rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3", 0x3C8123EA7B067637ULL },
+        { "rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4", 0x5C3F9B829B279560ULL },
+    };
+
+    int checkKeys() {
+        int failures = 0;
+        for (const KnownKey& known : KNOWN_KEYS) {
+            Position position;
+            position.setFromFen(known.fen);
+            uint64_t key = OpeningBook::hashKey(position);
+            bool ok = key == known.key;
+            std::cout << "  " << std::hex << std::setfill('0') << std::setw(16) << key << std::dec
+                      << std::setfill(' ') << (ok ? "  ok  " : "  FAIL  ") << known.fen << std::endl;
+            if (!ok) failures++;
+        }
+        std::cout << "[BookBuilder] " << (failures ? "Key mismatch in " + std::to_string(failures) + " position(s)"
+                                                   : std::string("All keys match")) << std::endl;
+        return failures ? 1 : 0;
+    }
+
+    void usage() {
+        std::cout << "Usage: BookBuilder <games.pgn>... -o <book.bin> [--plies N] [--min-games N]" << std::endl;
+        std::cout << "       BookBuilder --probe <book.bin> [--fen \"<fen>\"]" << std::endl;
+        std::cout << "       BookBuilder --check" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    BuildOptions options;
+    std::vector<std::string> inputs;
+    std::string output;
+    std::string probePath;
+    std::string fen = START_FEN;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) output = argv[++i];
+        else if (arg == "--plies" && i + 1 < argc) options.maxPlies = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--min-games" && i + 1 < argc) options.minGames = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--probe" && i + 1 < argc) probePath = argv[++i];
+        else if (arg == "--fen" && i + 1 < argc) fen = argv[++i];
+        else if (arg == "--check") return checkKeys();
+        else if (!arg.empty() && arg[0] != '-') inputs.push_back(arg);
+        else {
+            usage();
+            return 1;
+        }
+    }
+
+    if (!probePath.empty()) return probe(probePath, fen);
+    if (inputs.empty() || output.empty()) {
+        usage();
+        return 1;
+    }
+
+    BookStats stats;
+    GameStats gameStats;
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string& input : inputs) {
+        std::ifstream file(input, std::ios::binary);
+        if (!file) {
+            std::cout << "[BookBuilder] Cannot open " << input << std::endl;
+            return 1;
+        }
+        readPgn(file, options, stats, gameStats);
+    }
+
+    std::vector<OpeningBook::Entry> entries = makeEntries(stats, options);
+    if (!OpeningBook::write(output, entries)) return 1;
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[BookBuilder] " << gameStats.games << " game(s) (" << gameStats.skipped
+              << " with unreadable moves), " << stats.size() << " position/move pairs, " << entries.size()
+              << " entries written to " << output << " in " << std::fixed << std::setprecision(2) << seconds
+              << " s" << std::endl;
+    return 0;
+}
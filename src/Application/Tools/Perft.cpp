@@ -0,0 +1,242 @@
+// Perft: compte les feuilles de l'arbre des coups légaux à profondeur fixe.
+// Sert de test de non-régression (comptes de référence connus) et de mesure de
+// débit pour MoveGenerator / Position::makeMove.
+//
+// Usage:
+//   Perft [depth] [--fen "<fen>"] [--epd <file>] [--divide] [--threads N]
+//
+// Sans --fen ni --epd, les positions standard intégrées sont vérifiées.
+
+#include "Entities/Position.h"
+#include "MoveGenerator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    struct PerftCase {
+        std::string fen;
+        std::vector<uint64_t> expected;  // expected[d - 1] = noeuds à la profondeur d
+    };
+
+    const std::vector<PerftCase> STANDARD_POSITIONS = {
+        { "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+          { 20, 400, 8902, 197281, 4865609, 119060324 } },
+        { "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",  // Kiwipete
+          { 48, 2039, 97862, 4085603, 193690690 } },
+        { "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+          { 14, 191, 2812, 43238, 674624, 11030083 } },
+        { "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+          { 6, 264, 9467, 422333, 15833292 } },
+        { "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+          { 44, 1486, 62379, 2103487, 89941194 } },
+        { "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+          { 46, 2079, 89890, 3894594, 164075551 } }
+    };
+
+    // Comptage "bulk": au dernier niveau, la taille de la liste légale suffit
+    uint64_t perft(Position& position, int depth) {
+        MoveList moves;
+        MoveGenerator(position).generateLegalMoves(position.sideToMove(), moves);
+        if (depth <= 1) return depth == 1 ? moves.size() : 1;
+
+        uint64_t nodes = 0;
+        StateInfo state;
+        for (PackedMove move : moves) {
+            position.makeMove(move, state);
+            nodes += perft(position, depth - 1);
+            position.unmakeMove(move, state);
+        }
+        return nodes;
+    }
+
+    struct RootResult {
+        PackedMove move;
+        uint64_t nodes;
+    };
+
+    // Répartit les coups de la racine entre les threads (chacun sur sa propre copie)
+    std::vector<RootResult> perftRoot(const Position& root, int depth, int threadCount) {
+        MoveList moves;
+        MoveGenerator(root).generateLegalMoves(root.sideToMove(), moves);
+
+        std::vector<RootResult> results(moves.size());
+        std::atomic<int> nextMove{ 0 };
+
+        auto worker = [&]() {
+            Position position = root;
+            StateInfo state;
+            for (int i = nextMove++; i < moves.size(); i = nextMove++) {
+                position.makeMove(moves[i], state);
+                results[i] = { moves[i], perft(position, depth - 1) };
+                position.unmakeMove(moves[i], state);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int i = 1; i < threadCount; i++) threads.emplace_back(worker);
+        worker();
+        for (std::thread& thread : threads) thread.join();
+        return results;
+    }
+
+    struct RunStats {
+        uint64_t nodes = 0;
+        double seconds = 0.0;
+    };
+
+    RunStats runPerft(const Position& position, int depth, int threadCount, bool divide) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<RootResult> results = perftRoot(position, depth, threadCount);
+        auto end = std::chrono::steady_clock::now();
+
+        RunStats stats;
+        stats.seconds = std::chrono::duration<double>(end - start).count();
+        for (const RootResult& result : results) {
+            stats.nodes += result.nodes;
+            if (divide) {
+                std::cout << "  " << toUciString(result.move) << ": " << result.nodes << std::endl;
+            }
+        }
+        return stats;
+    }
+
+    std::string formatNps(const RunStats& stats) {
+        std::ostringstream out;
+        out << static_cast<uint64_t>(stats.seconds > 0 ? stats.nodes / stats.seconds : 0) << " nps";
+        return out.str();
+    }
+
+    // Ligne EPD: "<fen> ;D1 20 ;D2 400 ..."
+    bool parseEpdLine(const std::string& line, PerftCase& out) {
+        size_t separator = line.find(';');
+        out.fen = line.substr(0, separator);
+        out.expected.clear();
+        if (out.fen.find_first_not_of(" \t\r") == std::string::npos || out.fen[0] == '#') return false;
+
+        while (separator != std::string::npos) {
+            size_t next = line.find(';', separator + 1);
+            std::istringstream field(line.substr(separator + 1, next - separator - 1));
+            std::string tag;
+            uint64_t nodes = 0;
+            if (field >> tag >> nodes && tag.size() > 1 && tag[0] == 'D') {
+                size_t depth = std::stoul(tag.substr(1));
+                if (depth > 0) {
+                    if (out.expected.size() < depth) out.expected.resize(depth, 0);
+                    out.expected[depth - 1] = nodes;
+                }
+            }
+            separator = next;
+        }
+        return true;
+    }
+
+    // Vérifie chaque position jusqu'à depth; renvoie le nombre d'échecs
+    int runSuite(const std::vector<PerftCase>& cases, int depth, int threadCount) {
+        int failures = 0;
+        RunStats single, parallel;
+
+        for (const PerftCase& testCase : cases) {
+            Position position;
+            if (!position.setFromFen(testCase.fen)) {
+                std::cout << "[Perft] Invalid FEN: " << testCase.fen << std::endl;
+                failures++;
+                continue;
+            }
+
+            // Profondeur connue la plus grande qui ne dépasse pas celle demandée
+            int caseDepth = std::min<int>(depth, static_cast<int>(testCase.expected.size()));
+            while (caseDepth > 0 && testCase.expected[caseDepth - 1] == 0) caseDepth--;
+            if (caseDepth < 1) continue;
+            uint64_t expected = testCase.expected[caseDepth - 1];
+
+            RunStats stats = runPerft(position, caseDepth, 1, false);
+            single.nodes += stats.nodes;
+            single.seconds += stats.seconds;
+            bool ok = stats.nodes == expected;
+            if (threadCount > 1) {
+                RunStats threaded = runPerft(position, caseDepth, threadCount, false);
+                parallel.nodes += threaded.nodes;
+                parallel.seconds += threaded.seconds;
+                ok = ok && threaded.nodes == expected;
+            }
+
+            if (!ok) failures++;
+            std::cout << (ok ? "[OK]   " : "[FAIL] ") << testCase.fen << "  depth " << caseDepth
+                      << ": " << stats.nodes;
+            if (!ok) std::cout << " (expected " << expected << ")";
+            std::cout << "  " << formatNps(stats) << std::endl;
+        }
+
+        std::cout << "[Perft] " << single.nodes << " nodes, 1 thread: " << formatNps(single);
+        if (threadCount > 1) {
+            std::cout << ", " << threadCount << " threads: " << formatNps(parallel)
+                      << " (x" << (parallel.seconds > 0 ? single.seconds / parallel.seconds : 0.0) << ")";
+        }
+        std::cout << std::endl;
+        std::cout << "[Perft] " << (failures ? "FAILED: " + std::to_string(failures) + " position(s)" : "All positions match")
+                  << std::endl;
+        return failures;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int depth = 5;
+    int threadCount = std::max(1u, std::thread::hardware_concurrency());
+    bool divide = false;
+    std::string fen;
+    std::string epdFile;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--fen" && i + 1 < argc) fen = argv[++i];
+        else if (arg == "--epd" && i + 1 < argc) epdFile = argv[++i];
+        else if (arg == "--threads" && i + 1 < argc) threadCount = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--divide") divide = true;
+        else if (std::atoi(arg.c_str()) > 0) depth = std::atoi(arg.c_str());
+        else {
+            std::cout << "Usage: Perft [depth] [--fen \"<fen>\"] [--epd <file>] [--divide] [--threads N]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Position unique: affichage détaillé (divide) et débit
+    if (!fen.empty()) {
+        Position position;
+        if (!position.setFromFen(fen)) {
+            std::cout << "[Perft] Invalid FEN: " << fen << std::endl;
+            return 1;
+        }
+        RunStats stats = runPerft(position, depth, threadCount, divide);
+        std::cout << "[Perft] depth " << depth << ": " << stats.nodes << " nodes in "
+                  << static_cast<int>(stats.seconds * 1000) << " ms (" << formatNps(stats)
+                  << ", " << threadCount << " thread(s))" << std::endl;
+        return 0;
+    }
+
+    std::vector<PerftCase> cases = STANDARD_POSITIONS;
+    if (!epdFile.empty()) {
+        std::ifstream file(epdFile);
+        if (!file.is_open()) {
+            std::cout << "[Perft] Cannot open " << epdFile << std::endl;
+            return 1;
+        }
+        cases.clear();
+        std::string line;
+        PerftCase testCase;
+        while (std::getline(file, line)) {
+            if (parseEpdLine(line, testCase)) cases.push_back(testCase);
+        }
+    }
+
+    return runSuite(cases, depth, threadCount) == 0 ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+#include "Entities/Bitboard.h"
+
+namespace Bitboards {
+
+Magic RookMagics[SQUARE_COUNT];
+Magic BishopMagics[SQUARE_COUNT];
+
+namespace {
+
+    // Tables partagées par toutes les cases (tailles exactes pour des magics "fancy")
+    Bitboard s_rookTable[0x19000];
+    Bitboard s_bishopTable[0x1480];
+
+    const int BishopDirections[4][2] = { {1, 1}, {1, -1}, {-1, 1}, {-1, -1} };
+    const int RookDirections[4][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1} };
+
+    using detail::isOnBoard;
+
+    // Marche case par case dans chaque direction jusqu'au premier bloqueur (inclus).
+    // Sert uniquement à construire les tables magic au démarrage.
+    Bitboard slidingAttacks(int square, Bitboard occupied, const int directions[4][2]) {
+        Bitboard attacks = 0;
+        for (int d = 0; d < 4; d++) {
+            int rank = rankOf(square) + directions[d][0];
+            int file = fileOf(square) + directions[d][1];
+            while (isOnBoard(rank, file)) {
+                Bitboard target = squareBB(rank * 8 + file);
+                attacks |= target;
+                if (occupied & target) break;
+                rank += directions[d][0];
+                file += directions[d][1];
+            }
+        }
+        return attacks;
+    }
+
+    // Générateur xorshift64* déterministe: les mêmes magics sont trouvés à chaque démarrage
+    class MagicRandom {
+    public:
+        explicit MagicRandom(uint64_t seed) : m_state(seed) {}
+
+        uint64_t next() {
+            m_state ^= m_state >> 12;
+            m_state ^= m_state << 25;
+            m_state ^= m_state >> 27;
+            return m_state * 2685821657736338717ULL;
+        }
+
+        // Peu de bits à 1: les bons magics sont généralement creux
+        uint64_t sparse() { return next() & next() & next(); }
+
+    private:
+        uint64_t m_state;
+    };
+
+    // Remplit magics[] et la table d'attaques partagée pour un type de pièce glissante.
+    // Pour chaque case: masque des cases pertinentes (bords exclus), énumération de tous
+    // les sous-ensembles d'occupation (Carry-Rippler), puis recherche d'un magic sans collision.
+    void initMagics(Magic magics[], Bitboard table[], const int directions[4][2]) {
+        // Graines choisies pour converger vite (une par rangée)
+        const uint64_t seeds[8] = { 728, 10316, 55013, 32803, 12281, 15100, 16645, 255 };
+
+        Bitboard occupancy[4096];
+        Bitboard reference[4096];
+        int epoch[4096] = {};
+        int currentEpoch = 0;
+        int size = 0;
+
+        for (int square = 0; square < SQUARE_COUNT; square++) {
+            Bitboard edges = ((RANK_1_BB | RANK_8_BB) & ~(RANK_1_BB << (8 * rankOf(square))))
+                           | ((FILE_A_BB | FILE_H_BB) & ~(FILE_A_BB << fileOf(square)));
+
+            Magic& m = magics[square];
+            m.mask = slidingAttacks(square, 0, directions) & ~edges;
+            m.shift = 64 - popCount(m.mask);
+            m.attacks = (square == 0) ? table : magics[square - 1].attacks + size;
+
+            size = 0;
+            Bitboard subset = 0;
+            do {
+                occupancy[size] = subset;
+                reference[size] = slidingAttacks(square, subset, directions);
+#ifdef USE_PEXT
+                m.attacks[_pext_u64(subset, m.mask)] = reference[size];
+#endif
+                size++;
+                subset = (subset - m.mask) & m.mask;
+            } while (subset);
+
+#ifndef USE_PEXT
+            MagicRandom random(seeds[rankOf(square)]);
+            for (int i = 0; i < size; ) {
+                do {
+                    m.magic = random.sparse();
+                } while (popCount((m.mask * m.magic) >> 56) < 6);
+
+                // Vérifier que chaque occupation tombe sur une entrée libre ou déjà identique
+                currentEpoch++;
+                for (i = 0; i < size; i++) {
+                    unsigned index = m.index(occupancy[i]);
+                    if (epoch[index] < currentEpoch) {
+                        epoch[index] = currentEpoch;
+                        m.attacks[index] = reference[i];
+                    } else if (m.attacks[index] != reference[i]) {
+                        break;
+                    }
+                }
+            }
+#endif
+        }
+    }
+
+    // Les tables sont prêtes avant main()
+    struct TableInitializer {
+        TableInitializer() { init(); }
+    } s_tableInitializer;
+}
+
+void init() {
+    static bool initialized = false;
+    if (initialized) return;
+    initialized = true;
+
+    initMagics(RookMagics, s_rookTable, RookDirections);
+    initMagics(BishopMagics, s_bishopTable, BishopDirections);
+}
+
+} // namespace Bitboards
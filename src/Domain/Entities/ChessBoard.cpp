@@ -2,13 +2,14 @@
 #include "Entities/ChessPiece.h"
 #include "BoardTheme.h"
 #include "Rules/MoveValidator.h"
+#include "MoveGenerator.h"
 #include <iostream>
 #include <sstream>
 #include <cmath>
 
 using namespace std;
 
-ChessBoard::ChessBoard() : texturesLoaded(false), squareSize(50.f), boardX(50.f), boardY(50.f), halfMoveClock(0), currentPieceSet(PieceSetType::CLASSIC),
+ChessBoard::ChessBoard() : texturesLoaded(false), squareSize(50.f), boardX(50.f), boardY(50.f), currentPieceSet(PieceSetType::CLASSIC),
     whiteKingDangerPos(-1, -1), blackKingDangerPos(-1, -1) {
     for (int row = 0; row < 8; row++) {
         for (int col = 0; col < 8; col++) {
@@ -142,92 +143,78 @@ void ChessBoard::initialize(float x, float y, float size, const ThemeColors& the
     if (!piecesExist) {
         std::cout << "[ChessBoard] Setting up initial pieces" << std::endl;
         
-        for (int row = 0; row < 8; row++) {
-            for (int col = 0; col < 8; col++) {
-                if (pieces[row][col]) {
-                    delete pieces[row][col];
-                }
-                pieces[row][col] = nullptr;
-            }
-        }
-
-        for (int col = 0; col < 8; col++) {
-            setupPiece(1, col, "pawn", "black");
-            setupPiece(6, col, "pawn", "white");
-        }
-
-        std::string backRow[] = { "rook", "knight", "bishop", "queen", "king", "bishop", "knight", "rook" };
-        for (int col = 0; col < 8; col++) {
-            setupPiece(0, col, backRow[col], "black");
-            setupPiece(7, col, backRow[col], "white");
-        }
-
-        while (!moveHistory.empty()) moveHistory.pop();
-        
-        // Réinitialiser le tracking de fin de partie
-        halfMoveClock = 0;
-        positionHistory.clear();
-        recordCurrentPosition();
+        // Position initiale, historique d'annulation et de répétition vidés
+        game.reset();
+        syncPiecesFromPosition();
     } else {
         std::cout << "[ChessBoard] Updating existing piece positions for new geometry" << std::endl;
         // Update sprite positions for existing pieces
         for (int row = 0; row < 8; row++) {
             for (int col = 0; col < 8; col++) {
-                if (pieces[row][col] && !pieces[row][col]->type.empty()) {
-                    pieces[row][col]->sprite.setPosition(
-                        boardX + col * squareSize + squareSize / 2,
-                        boardY + row * squareSize + squareSize / 2
-                    );
-                }
+                updatePieceView(row, col);
             }
         }
     }
 }
 
 void ChessBoard::setupPiece(int row, int col, const std::string& type, const std::string& color) {
-    if (!texturesLoaded) {
-        // still create a minimal ChessPiece to avoid null checks elsewhere
-        if (pieces[row][col]) delete pieces[row][col];
-        pieces[row][col] = new ChessPiece();
-        pieces[row][col]->type = type;
-        pieces[row][col]->color = color;
-        pieces[row][col]->row = row;
-        pieces[row][col]->col = col;
-        pieces[row][col]->hasMoved = false;
-        return;
-    }
+    game.putPiece(makePiece(colorFromString(color), pieceTypeFromString(type)), squareAt(row, col));
+    createPiece(row, col, type, color);
+}
 
-    int textureIndex = (color == "white" ? 0 : 6);
-    if (type == "pawn") textureIndex += 0;
-    else if (type == "rook") textureIndex += 1;
-    else if (type == "knight") textureIndex += 2;
-    else if (type == "bishop") textureIndex += 3;
-    else if (type == "queen") textureIndex += 4;
-    else if (type == "king") textureIndex += 5;
+void ChessBoard::syncPiecesFromPosition() {
+    // Reconstruit les objets d'affichage à partir de la position (undo, chargement)
+    for (int row = 0; row < 8; row++) {
+        for (int col = 0; col < 8; col++) {
+            if (pieces[row][col]) {
+                delete pieces[row][col];
+                pieces[row][col] = nullptr;
+            }
+            Piece piece = game.position().pieceOn(squareAt(row, col));
+            if (piece != NO_PIECE) {
+                createPiece(row, col, toString(typeOf(piece)), toString(colorOf(piece)));
+            }
+            updatePieceView(row, col);
+        }
+    }
+}
 
+void ChessBoard::createPiece(int row, int col, const std::string& type, const std::string& color) {
     if (pieces[row][col]) {
         delete pieces[row][col];
         pieces[row][col] = nullptr;
     }
 
     pieces[row][col] = new ChessPiece();
-    pieces[row][col]->sprite.setTexture(pieceTextures[textureIndex]);
     pieces[row][col]->type = type;
     pieces[row][col]->color = color;
     pieces[row][col]->row = row;
     pieces[row][col]->col = col;
     pieces[row][col]->hasMoved = false;
 
-    float scale = squareSize / std::max(pieceTextures[textureIndex].getSize().x,
-        pieceTextures[textureIndex].getSize().y) * 0.8f;
-    pieces[row][col]->sprite.setScale(scale, scale);
+    updatePieceView(row, col);
+}
+
+void ChessBoard::updatePieceView(int row, int col) {
+    // Le sprite suit la pièce de la case: texture selon type/couleur, centré sur la case
+    PieceView& view = pieceViews[row][col];
+    const ChessPiece* piece = pieces[row][col];
+    view.setPiece(piece);
+    if (!piece || piece->type.empty()) return;
 
-    sf::FloatRect bounds = pieces[row][col]->sprite.getLocalBounds();
-    pieces[row][col]->sprite.setOrigin(bounds.width / 2, bounds.height / 2);
-    pieces[row][col]->sprite.setPosition(
-        boardX + col * squareSize + squareSize / 2,
-        boardY + row * squareSize + squareSize / 2
-    );
+    if (texturesLoaded) {
+        int textureIndex = (piece->color == "white" ? 0 : 6);
+        if (piece->type == "pawn") textureIndex += 0;
+        else if (piece->type == "rook") textureIndex += 1;
+        else if (piece->type == "knight") textureIndex += 2;
+        else if (piece->type == "bishop") textureIndex += 3;
+        else if (piece->type == "queen") textureIndex += 4;
+        else if (piece->type == "king") textureIndex += 5;
+        view.setTexture(pieceTextures[textureIndex], squareSize);
+    }
+
+    view.setCenter(boardX + col * squareSize + squareSize / 2,
+                   boardY + row * squareSize + squareSize / 2);
 }
 
 void ChessBoard::draw(sf::RenderWindow& window) {
@@ -248,9 +235,7 @@ void ChessBoard::draw(sf::RenderWindow& window) {
     // 4. Dessiner les pièces par-dessus tout
     for (int row = 0; row < 8; row++) {
         for (int col = 0; col < 8; col++) {
-            if (pieces[row][col] && !pieces[row][col]->type.empty()) {
-                window.draw(pieces[row][col]->sprite);
-            }
+            pieceViews[row][col].draw(window);
         }
     }
 }
@@ -303,10 +288,12 @@ void ChessBoard::removePiece(int row, int col) {
             delete pieces[row][col];
             pieces[row][col] = nullptr;
         }
+        updatePieceView(row, col);
+        game.removePiece(squareAt(row, col));
     }
 }
 
-void ChessBoard::setPieceByNames(int row, int col, const std::string& type, const std::string& color) {
+void ChessBoard::setPiece(int row, int col, PieceType type, Color color) {
     if (row < 0 || row >= 8 || col < 0 || col >= 8) return;
 
     if (pieces[row][col]) {
@@ -315,111 +302,23 @@ void ChessBoard::setPieceByNames(int row, int col, const std::string& type, cons
     }
 
     // setupPiece will handle textures and positioning
-    setupPiece(row, col, type, color);
+    setupPiece(row, col, toString(type), toString(color));
 }
 
-// Integrated move validation logic from extracted code
-bool ChessBoard::isValidPawnMove(int fromRow, int fromCol, int toRow, int toCol, const std::string& color) {
-    int direction = (color == "white") ? -1 : 1;
-    ChessPiece* target = getPieceAt(toRow, toCol);
-    ChessPiece* fromPiece = getPieceAt(fromRow, fromCol);
+bool ChessBoard::isValidMove(int fromRow, int fromCol, int toRow, int toCol) {
+    if (!isInsideBoard(fromRow, fromCol) || !isInsideBoard(toRow, toCol)) return false;
 
-    // Forward movement
-    if (fromCol == toCol) {
-        if (target && !target->type.empty()) return false; // must be empty
-        
-        // One square forward
-        if (toRow == fromRow + direction) return true;
-        
-        // Two squares on first move
-        if (fromPiece && !fromPiece->hasMoved && toRow == fromRow + 2 * direction) {
-            ChessPiece* intermediate = getPieceAt(fromRow + direction, fromCol);
-            return (!intermediate || intermediate->type.empty());
+    // Coup pseudo-légal selon la position (la sécurité du roi est vérifiée par MoveValidator)
+    MoveGenerator generator(game.position());
+    for (const Move& move : generator.generateMovesForPiece(fromRow, fromCol)) {
+        if (move.toRow == toRow && move.toCol == toCol) {
+            return true;
         }
     }
-    // Diagonal capture
-    else if (abs(fromCol - toCol) == 1 && toRow == fromRow + direction) {
-        return (target && !target->type.empty() && target->color != color);
-    }
-
     return false;
 }
 
-bool ChessBoard::isValidRookMove(int fromRow, int fromCol, int toRow, int toCol) {
-    if (fromRow != toRow && fromCol != toCol) return false;
-
-    // Check path is clear
-    if (fromRow == toRow) { // horizontal
-        int step = (toCol > fromCol) ? 1 : -1;
-        for (int col = fromCol + step; col != toCol; col += step) {
-            if (getPieceAt(fromRow, col) && !getPieceAt(fromRow, col)->type.empty()) {
-                return false;
-            }
-        }
-    } else { // vertical
-        int step = (toRow > fromRow) ? 1 : -1;
-        for (int row = fromRow + step; row != toRow; row += step) {
-            if (getPieceAt(row, fromCol) && !getPieceAt(row, fromCol)->type.empty()) {
-                return false;
-            }
-        }
-    }
-    return true;
-}
-
-bool ChessBoard::isValidKnightMove(int fromRow, int fromCol, int toRow, int toCol) {
-    int rowDiff = abs(fromRow - toRow);
-    int colDiff = abs(fromCol - toCol);
-    return (rowDiff == 2 && colDiff == 1) || (rowDiff == 1 && colDiff == 2);
-}
-
-bool ChessBoard::isValidBishopMove(int fromRow, int fromCol, int toRow, int toCol) {
-    if (abs(fromRow - toRow) != abs(fromCol - toCol)) return false;
-
-    int rowStep = (toRow > fromRow) ? 1 : -1;
-    int colStep = (toCol > fromCol) ? 1 : -1;
-    int steps = abs(fromRow - toRow);
-    
-    for (int i = 1; i < steps; i++) {
-        int checkRow = fromRow + i * rowStep;
-        int checkCol = fromCol + i * colStep;
-        if (getPieceAt(checkRow, checkCol) && !getPieceAt(checkRow, checkCol)->type.empty()) {
-            return false;
-        }
-    }
-    return true;
-}
-
-bool ChessBoard::isValidQueenMove(int fromRow, int fromCol, int toRow, int toCol) {
-    return isValidRookMove(fromRow, fromCol, toRow, toCol) ||
-           isValidBishopMove(fromRow, fromCol, toRow, toCol);
-}
-
-bool ChessBoard::isValidKingMove(int fromRow, int fromCol, int toRow, int toCol) {
-    int rowDiff = abs(fromRow - toRow);
-    int colDiff = abs(fromCol - toCol);
-    return (rowDiff <= 1 && colDiff <= 1);
-}
-
-bool ChessBoard::isValidMove(int fromRow, int fromCol, int toRow, int toCol) {
-    ChessPiece* fromPiece = getPieceAt(fromRow, fromCol);
-    ChessPiece* toPiece = getPieceAt(toRow, toCol);
-
-    if (!fromPiece || fromPiece->type.empty()) return false;
-    if (toPiece && !toPiece->type.empty() && toPiece->color == fromPiece->color) return false;
-
-    const std::string& type = fromPiece->type;
-    if (type == "pawn") return isValidPawnMove(fromRow, fromCol, toRow, toCol, fromPiece->color);
-    else if (type == "rook") return isValidRookMove(fromRow, fromCol, toRow, toCol);
-    else if (type == "knight") return isValidKnightMove(fromRow, fromCol, toRow, toCol);
-    else if (type == "bishop") return isValidBishopMove(fromRow, fromCol, toRow, toCol);
-    else if (type == "queen") return isValidQueenMove(fromRow, fromCol, toRow, toCol);
-    else if (type == "king") return isValidKingMove(fromRow, fromCol, toRow, toCol);
-
-    return false;
-}
-
-bool ChessBoard::movePiece(int fromRow, int fromCol, int toRow, int toCol, const std::string& promotionPiece) {
+bool ChessBoard::movePiece(int fromRow, int fromCol, int toRow, int toCol, PieceType promotionPiece) {
     std::cout << "[ChessBoard] movePiece called: (" << fromRow << "," << fromCol << ") -> (" << toRow << "," << toCol << ")" << std::endl;
     
     if (fromRow < 0 || fromRow >= 8 || fromCol < 0 || fromCol >= 8 ||
@@ -444,27 +343,29 @@ bool ChessBoard::movePiece(int fromRow, int fromCol, int toRow, int toCol, const
 
     std::cout << "[ChessBoard] Moving " << fromPiece->type << " " << fromPiece->color << std::endl;
 
-    std::string capturedType = toPiece ? toPiece->type : "";
-    std::string capturedColor = toPiece ? toPiece->color : "";
-    bool wasFirstMove = fromPiece->hasMoved;
-    
-    // Mettre à jour le compteur de demi-coups pour la règle des 50 coups
-    bool isPawnMove = (fromPiece->type == "pawn");
-    bool isCapture = (toPiece && !toPiece->type.empty());
-    
-    if (isPawnMove || isCapture) {
-        halfMoveClock = 0;
-    } else {
-        halfMoveClock++;
-    }
+    PackedMove move = toPackedMove(Move(fromRow, fromCol, toRow, toCol), game.position());
+    Piece moving = game.position().pieceOn(move.from());
+    bool isPawnMove = typeOf(moving) == PieceType::Pawn;
+    bool isEnPassant = move.flag() == EN_PASSANT_MOVE;
+    bool isCastling = move.flag() == CASTLING_MOVE;
 
-    moveHistory.push(Move(fromRow, fromCol, toRow, toCol, capturedType, capturedColor, wasFirstMove));
+    // Jouer le coup sur la position (sauvegardée pour undoMove, clé enregistrée pour
+    // les répétitions); la promotion éventuelle est appliquée plus bas par promotePawn
+    game.playMove(move);
 
     if (toPiece) {
         std::cout << "[ChessBoard] Capturing " << toPiece->type << " " << toPiece->color << std::endl;
         delete toPiece;
     }
 
+    if (isEnPassant) {
+        // Le pion pris en passant est à côté de la case de départ
+        std::cout << "[ChessBoard] En passant capture" << std::endl;
+        delete pieces[fromRow][toCol];
+        pieces[fromRow][toCol] = nullptr;
+        updatePieceView(fromRow, toCol);
+    }
+
     pieces[toRow][toCol] = fromPiece;
     pieces[fromRow][fromCol] = nullptr;
 
@@ -473,32 +374,42 @@ bool ChessBoard::movePiece(int fromRow, int fromCol, int toRow, int toCol, const
     fromPiece->hasMoved = true;
 
     // Recalculate position based on current board geometry
-    fromPiece->sprite.setPosition(
-        boardX + toCol * squareSize + squareSize / 2,
-        boardY + toRow * squareSize + squareSize / 2
-    );
+    updatePieceView(fromRow, fromCol);
+    updatePieceView(toRow, toCol);
+
+    if (isCastling) {
+        // Déplacer la tour à côté du roi
+        int rookFromCol = (toCol > fromCol) ? 7 : 0;
+        int rookToCol = (toCol > fromCol) ? 5 : 3;
+        ChessPiece* rook = pieces[fromRow][rookFromCol];
+        pieces[fromRow][rookToCol] = rook;
+        pieces[fromRow][rookFromCol] = nullptr;
+        if (rook) {
+            rook->col = rookToCol;
+            rook->hasMoved = true;
+        }
+        updatePieceView(fromRow, rookFromCol);
+        updatePieceView(fromRow, rookToCol);
+    }
     
     // Record last move for visual highlighting
     setLastMove(fromRow, fromCol, toRow, toCol);
     
     // Check for pawn promotion
     if (isPawnMove) {
-        bool isWhite = (fromPiece->color == "white");
-        int promotionRow = isWhite ? 0 : 7;
+        int promotionRow = colorOf(moving) == Color::White ? 0 : 7;
         
         if (toRow == promotionRow) {
             // Only auto-promote if a piece is explicitly specified
-            if (!promotionPiece.empty()) {
-                std::cout << "[ChessBoard] Pawn reached promotion row! Promoting to " << promotionPiece << std::endl;
+            if (promotionPiece != PieceType::None) {
+                std::cout << "[ChessBoard] Pawn reached promotion row! Promoting to " << toString(promotionPiece) << std::endl;
                 promotePawn(toRow, toCol, promotionPiece);
             } else {
                 std::cout << "[ChessBoard] Pawn reached promotion row - waiting for piece selection" << std::endl;
             }
         }
     }
-    
-    // Enregistrer la nouvelle position pour la détection de répétition
-    recordCurrentPosition();
+
 
     std::cout << "[ChessBoard] Move completed successfully" << std::endl;
     return true;
@@ -506,47 +417,16 @@ bool ChessBoard::movePiece(int fromRow, int fromCol, int toRow, int toCol, const
 
 // Overload for backward compatibility (automatic queen promotion for AI)
 bool ChessBoard::movePiece(int fromRow, int fromCol, int toRow, int toCol) {
-    return movePiece(fromRow, fromCol, toRow, toCol, "queen");
+    return movePiece(fromRow, fromCol, toRow, toCol, PieceType::Queen);
 }
 
 bool ChessBoard::undoMove() {
-    if (moveHistory.empty()) return false;
-
-    Move lastMove = moveHistory.top();
-    moveHistory.pop();
-
-    ChessPiece* movedPiece = pieces[lastMove.toRow][lastMove.toCol];
-
-    pieces[lastMove.fromRow][lastMove.fromCol] = movedPiece;
-    pieces[lastMove.toRow][lastMove.toCol] = nullptr;
-
-    if (!lastMove.capturedType.empty()) {
-        setupPiece(lastMove.toRow, lastMove.toCol, lastMove.capturedType, lastMove.capturedColor);
-    }
-
-    if (movedPiece) {
-        movedPiece->row = lastMove.fromRow;
-        movedPiece->col = lastMove.fromCol;
-        movedPiece->hasMoved = lastMove.wasFirstMove;
-
-        movedPiece->sprite.setPosition(
-            boardX + lastMove.fromCol * squareSize + squareSize / 2,
-            boardY + lastMove.fromRow * squareSize + squareSize / 2
-        );
-    }
+    // Restaurer la position exacte (roques, en passant, compteurs) et les sprites
+    if (!game.undoMove()) return false;
+    syncPiecesFromPosition();
     
     // Clear last move highlight on undo
     clearLastMove();
-    
-    // Retirer la dernière position de l'historique
-    if (!positionHistory.empty()) {
-        positionHistory.pop_back();
-    }
-    
-    // Réduire le compteur de demi-coups (approximatif, pas parfait pour undo)
-    if (halfMoveClock > 0) {
-        halfMoveClock--;
-    }
 
     return true;
 }
@@ -555,30 +435,26 @@ bool ChessBoard::undoMove() {
 // King Danger Detection & Visual Alert System
 // ================================
 
-std::pair<int, int> ChessBoard::getKingPosition(const std::string& color) const {
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const ChessPiece* piece = pieces[row][col];
-            if (piece && piece->type == "king" && piece->color == color) {
-                return {row, col};
-            }
-        }
+std::pair<int, int> ChessBoard::getKingPosition(Color color) const {
+    int square = game.position().kingSquare(color);
+    if (square == NO_SQUARE) {
+        return {-1, -1}; // King not found (should never happen in valid game)
     }
-    return {-1, -1}; // King not found (should never happen in valid game)
+    return {rowOf(square), colOf(square)};
 }
 
-bool ChessBoard::isKingInDanger(const std::string& color) const {
+bool ChessBoard::isKingInDanger(Color color) const {
     // Cette méthode délègue au MoveValidator::isInCheck
     // Elle sera appelée depuis GameController qui a accès au validator
     // Ici on retourne juste si la position de danger est définie
-    if (color == "white") {
+    if (color == Color::White) {
         return whiteKingDangerPos.first != -1 && whiteKingDangerPos.second != -1;
     } else {
         return blackKingDangerPos.first != -1 && blackKingDangerPos.second != -1;
     }
 }
 
-void ChessBoard::updateKingDangerStatus(const std::string& color, const MoveValidator* validator) {
+void ChessBoard::updateKingDangerStatus(Color color, const MoveValidator* validator) {
     if (!validator) {
         clearKingDangerStatus();
         return;
@@ -592,11 +468,11 @@ void ChessBoard::updateKingDangerStatus(const std::string& color, const MoveVali
         std::pair<int, int> kingPos = getKingPosition(color);
         
         if (kingPos.first != -1) {
-            std::cout << "[ChessBoard] " << color << " king is IN DANGER at (" 
+            std::cout << "[ChessBoard] " << toString(color) << " king is IN DANGER at (" 
                       << kingPos.first << "," << kingPos.second << ")" << std::endl;
             
             // Enregistrer la position de danger
-            if (color == "white") {
+            if (color == Color::White) {
                 whiteKingDangerPos = kingPos;
             } else {
                 blackKingDangerPos = kingPos;
@@ -604,7 +480,7 @@ void ChessBoard::updateKingDangerStatus(const std::string& color, const MoveVali
         }
     } else {
         // Le roi n'est pas en danger, effacer le statut
-        if (color == "white") {
+        if (color == Color::White) {
             whiteKingDangerPos = {-1, -1};
         } else {
             blackKingDangerPos = {-1, -1};
@@ -641,22 +517,20 @@ void ChessBoard::highlightKingDanger(sf::RenderWindow& window) {
     }
 }
 
-void ChessBoard::promotePawn(int row, int col, const std::string& promotionPiece) {
-    ChessPiece* pawn = pieces[row][col];
-    if (!pawn || pawn->type != "pawn") {
+void ChessBoard::promotePawn(int row, int col, PieceType promotionPiece) {
+    int square = squareAt(row, col);
+    Piece pawn = game.position().pieceOn(square);
+    if (typeOf(pawn) != PieceType::Pawn) {
         std::cout << "[ChessBoard] ERROR: No pawn at position (" << row << "," << col << ") to promote" << std::endl;
         return;
     }
     
-    std::string color = pawn->color;
-    std::cout << "[ChessBoard] Promoting " << color << " pawn at (" << row << "," << col << ") to " << promotionPiece << std::endl;
+    std::string color = toString(colorOf(pawn));
+    std::cout << "[ChessBoard] Promoting " << color << " pawn at (" << row << "," << col << ") to " << toString(promotionPiece) << std::endl;
     
-    // Delete the pawn
-    delete pawn;
-    pieces[row][col] = nullptr;
-    
-    // Create the new promoted piece
-    setupPiece(row, col, promotionPiece, color);
+    // Remplacer le pion dans la position (et sa clé enregistrée), puis la pièce affichée
+    game.promote(square, promotionPiece);
+    createPiece(row, col, toString(promotionPiece), color);
     
     std::cout << "[ChessBoard] Pawn promotion complete" << std::endl;
 }
@@ -684,30 +558,6 @@ bool ChessBoard::isInsideBoard(int row, int col) const {
     return row >= 0 && row < 8 && col >= 0 && col < 8;
 }
 
-void ChessBoard::recordCurrentPosition() {
-    std::string hash = generatePositionHash();
-    positionHistory.push_back(hash);
-}
-
-std::string ChessBoard::generatePositionHash() const {
-    std::string hash;
-    
-    // Encoder la position de toutes les pièces
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const ChessPiece* piece = getPieceAt(row, col);
-            if (piece && !piece->type.empty()) {
-                hash += std::to_string(row) + std::to_string(col);
-                hash += piece->type.substr(0, 1);
-                hash += piece->color.substr(0, 1);
-                hash += "|";
-            }
-        }
-    }
-    
-    return hash;
-}
-
 void ChessBoard::setTheme(const ThemeColors& theme) {
     currentTheme = theme;
     
@@ -727,42 +577,14 @@ void ChessBoard::setTheme(const ThemeColors& theme) {
 void ChessBoard::reset() {
     std::cout << "[ChessBoard] Resetting board to initial state" << std::endl;
     
-    // Clear all existing pieces
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            if (pieces[row][col]) {
-                delete pieces[row][col];
-                pieces[row][col] = nullptr;
-            }
-        }
-    }
-    
-    // Setup pawns
-    for (int col = 0; col < 8; col++) {
-        setupPiece(1, col, "pawn", "black");
-        setupPiece(6, col, "pawn", "white");
-    }
-    
-    // Setup back row pieces
-    std::string backRow[] = { "rook", "knight", "bishop", "queen", "king", "bishop", "knight", "rook" };
-    for (int col = 0; col < 8; col++) {
-        setupPiece(0, col, backRow[col], "black");
-        setupPiece(7, col, backRow[col], "white");
-    }
-    
-    // Clear move history
-    while (!moveHistory.empty()) {
-        moveHistory.pop();
-    }
+    // Position initiale (historiques d'annulation et de répétition vidés)
+    // et pièces d'affichage correspondantes
+    game.reset();
+    syncPiecesFromPosition();
     
     // Clear last move highlight on reset
     clearLastMove();
     
-    // Reset game end tracking
-    halfMoveClock = 0;
-    positionHistory.clear();
-    recordCurrentPosition();
-    
     std::cout << "[ChessBoard] Board reset complete - all pieces in starting positions" << std::endl;
 }
 
@@ -876,7 +698,7 @@ void ChessBoard::setPieceSet(PieceSetType pieceSet, BoardTheme theme) {
                 if (pieces[row][col] && !pieces[row][col]->type.empty()) {
                     std::string type = pieces[row][col]->type;
                     std::string color = pieces[row][col]->color;
-                    setupPiece(row, col, type, color);
+                    createPiece(row, col, type, color);
                 }
             }
         }
@@ -0,0 +1,15 @@
+#include "Entities/Color.h"
+
+std::string toString(Color color) {
+    switch (color) {
+        case Color::White: return "white";
+        case Color::Black: return "black";
+        default: return "";
+    }
+}
+
+Color colorFromString(const std::string& name) {
+    if (name == "white") return Color::White;
+    if (name == "black") return Color::Black;
+    return Color::None;
+}
@@ -8,6 +8,17 @@
 #include <cmath>
 #include <iostream>
 
+namespace {
+    // Variation réduite à ses premiers coups (moves au plus), suivie de " ..." si elle est coupée
+    std::string truncatePv(const std::string& pv, int moves) {
+        size_t cut = 0;
+        for (int i = 0; i < moves && cut != std::string::npos; i++) {
+            cut = pv.find(' ', cut + 1);
+        }
+        return cut == std::string::npos ? pv : pv.substr(0, cut) + " ...";
+    }
+}
+
 GameBoardScreen::GameBoardScreen(ScreenManager* manager, GameController* gc)
     : Screen(manager), gameController(gc), boardInitialized(false),
       pendingPromotionRow(-1), pendingPromotionCol(-1) {
@@ -143,6 +154,14 @@ GameBoardScreen::GameBoardScreen(ScreenManager* manager, GameController* gc)
     aiStatusText.setFillColor(sf::Color::Yellow);
     aiStatusText.setStyle(sf::Text::Bold);
     
+    // Analysis lines - JetBrains Mono, so that scores line up
+    analysisText.setFont(*monoFont);
+    analysisText.setString("");
+    analysisText.setCharacterSize(UIStyles::Typography::CaptionSize);
+    analysisText.setFillColor(sf::Color::White);
+    analysisText.setOutlineColor(sf::Color::Black);
+    analysisText.setOutlineThickness(1.f);
+    
     // Game end text - Inter SemiBold
     gameEndText.setFont(*headingFont);
     gameEndText.setString("");
@@ -187,6 +206,16 @@ void GameBoardScreen::handleEvent(const sf::Event& event, const sf::Vector2i& mo
         return; // Don't process other events this frame
     }
     
+    // A: analysis mode on/off (best lines of the current position, updated each depth)
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::A) {
+        if (gameController->isAnalyzing()) {
+            gameController->stopAnalysis();
+        } else {
+            gameController->startAnalysis(3);
+        }
+        return;
+    }
+    
     if (event.type == sf::Event::MouseButtonPressed &&
         event.mouseButton.button == sf::Mouse::Left) {
 
@@ -301,6 +330,7 @@ void GameBoardScreen::update(float deltaTime) {
     updateScoreDisplay();
     updateClockDisplay();  // Update chess clock display
     updateAIStatus();
+    updateAnalysisDisplay();
 }
 
 void GameBoardScreen::draw(sf::RenderWindow& window) {
@@ -447,6 +477,13 @@ void GameBoardScreen::draw(sf::RenderWindow& window) {
     UIHelpers::centerText(blackClockText, blackClockPos.x + clockSize.x / 2.f, blackClockPos.y + clockSize.y / 2.f);
     window.draw(blackClockText);
 
+    // Analysis lines (below the white clock)
+    if (gameController->isAnalyzing()) {
+        analysisText.setCharacterSize((unsigned int)UIHelpers::scaleFont(12.f, winSizeF));
+        analysisText.setPosition(whiteClockPos.x, whiteClockPos.y + clockSize.y + clockSpacingBelowPanel);
+        window.draw(analysisText);
+    }
+
     // Chess board
     drawBoard(window);
 
@@ -565,7 +602,7 @@ void GameBoardScreen::updateAIStatus() {
     }
     
     if (gameController->isAIThinking()) {
-        float timeRemaining = gameController->getAIThinkingTimeRemaining();
+        float timeBudget = gameController->getAIThinkingTimeRemaining();
         
         // Animation de points pour montrer que l'IA réfléchit
         static sf::Clock statusClock;
@@ -576,13 +613,20 @@ void GameBoardScreen::updateAIStatus() {
             dots += ".";
         }
         
-        // Afficher le temps restant approximatif
-        int secondsLeft = (int)std::ceil(timeRemaining);
-        if (secondsLeft > 0) {
-            aiStatusText.setString("AI is thinking" + dots + " (" + std::to_string(secondsLeft) + "s left)");
-        } else {
-            aiStatusText.setString("AI is finishing" + dots);
+        // Budget de temps accordé par la pendule, puis avancement publié par la recherche
+        std::string status = "AI is thinking" + dots;
+        int budgetSeconds = (int)std::ceil(timeBudget);
+        if (budgetSeconds > 0) {
+            status += " (~" + std::to_string(budgetSeconds) + "s)";
+        }
+        
+        SearchProgress progress = gameController->getAIProgress();
+        if (progress.depth > 0) {
+            // Quelques coups de la variation principale suffisent à l'écran
+            status += "\ndepth " + std::to_string(progress.depth) + "  " + progress.score + "  "
+                    + truncatePv(progress.pv, 4);
         }
+        aiStatusText.setString(status);
         aiStatusText.setFillColor(sf::Color::Yellow);
         
         // Redémarrer le clock toutes les 1.2 secondes pour l'animation
@@ -593,11 +637,37 @@ void GameBoardScreen::updateAIStatus() {
         aiStatusText.setString("AI ready to move");
         aiStatusText.setFillColor(sf::Color::Cyan);
     } else {
-        aiStatusText.setString("Your turn to play");
+        // Pendant le tour du joueur, l'IA peut déjà chercher sa réponse (ponder), sans la dévoiler
+        aiStatusText.setString(gameController->isAIPondering() ? "Your turn to play (AI is pondering)"
+                                                               : "Your turn to play");
         aiStatusText.setFillColor(sf::Color::Green);
     }
 }
 
+void GameBoardScreen::updateAnalysisDisplay() {
+    if (!gameController->isAnalyzing()) {
+        analysisText.setString("");
+        return;
+    }
+    
+    SearchProgress analysis = gameController->getAnalysis();
+    if (analysis.depth == 0) {
+        analysisText.setString("Analysis...");
+        return;
+    }
+    
+    // En-tête: profondeur, profondeur sélective, débit; puis une ligne par variation
+    std::string text = "depth " + std::to_string(analysis.depth) + "/" + std::to_string(analysis.selDepth)
+                     + "  " + std::to_string(analysis.nodesPerSecond / 1000) + " kn/s";
+    for (size_t i = 0; i < analysis.lines.size(); i++) {
+        std::string score = analysis.lines[i].score;
+        if (score.size() < 7) score.append(7 - score.size(), ' ');
+        // Quelques coups par variation: le panneau est étroit
+        text += "\n" + std::to_string(i + 1) + ". " + score + " " + truncatePv(analysis.lines[i].pv, 3);
+    }
+    analysisText.setString(text);
+}
+
 void GameBoardScreen::updateTurnIndicator() {
     // Don't show turn indicator if game is ended
     if (gameController->isGameEnded()) {
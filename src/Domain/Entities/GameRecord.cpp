@@ -0,0 +1,71 @@
+#include "Entities/GameRecord.h"
+#include <algorithm>
+
+GameRecord::GameRecord() {
+    reset();
+}
+
+void GameRecord::reset(const Position& start) {
+    m_position = start;
+    while (!m_undoHistory.empty()) m_undoHistory.pop();
+    m_keyHistory.clear();
+    m_keyHistory.push_back(m_position.key());
+}
+
+void GameRecord::playMove(PackedMove move) {
+    m_undoHistory.push(m_position);
+    m_position.applyMove(move);
+    m_keyHistory.push_back(m_position.key());
+}
+
+bool GameRecord::undoMove() {
+    if (m_undoHistory.empty()) return false;
+
+    // Restaurer la position exacte (roques, en passant, compteurs)
+    m_position = m_undoHistory.top();
+    m_undoHistory.pop();
+    if (m_keyHistory.size() > 1) m_keyHistory.pop_back();
+    return true;
+}
+
+void GameRecord::promote(int square, PieceType type) {
+    Piece pawn = m_position.pieceOn(square);
+    if (pawn == NO_PIECE || typeOf(pawn) != PieceType::Pawn) return;
+
+    m_position.removePiece(square);
+    m_position.putPiece(makePiece(colorOf(pawn), type), square);
+
+    // La position enregistrée après le coup contient maintenant la pièce promue
+    refreshCurrentKey();
+}
+
+void GameRecord::putPiece(Piece piece, int square) {
+    m_position.putPiece(piece, square);
+    m_position.setCastlingRightsFromPlacement();
+    refreshCurrentKey();
+}
+
+void GameRecord::removePiece(int square) {
+    m_position.removePiece(square);
+    m_position.setCastlingRightsFromPlacement();
+    refreshCurrentKey();
+}
+
+int GameRecord::repetitionCount() const {
+    if (m_keyHistory.empty()) return 0;
+
+    // Une répétition ne peut pas traverser un coup irréversible (pion, prise):
+    // on ne remonte que halfMoveClock demi-coups, et seulement les positions du même camp
+    int last = static_cast<int>(m_keyHistory.size()) - 1;
+    int oldest = std::max(0, last - m_position.halfMoveClock());
+    int count = 1;
+    for (int i = last - 2; i >= oldest; i -= 2) {
+        if (m_keyHistory[i] == m_keyHistory[last]) count++;
+    }
+    return count;
+}
+
+void GameRecord::refreshCurrentKey() {
+    if (m_keyHistory.empty()) m_keyHistory.push_back(m_position.key());
+    else m_keyHistory.back() = m_position.key();
+}
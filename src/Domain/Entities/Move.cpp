@@ -1,3 +1,9 @@
 #include "Move.h"
 
-// Move constructor is implemented in ChessPiece.cpp to avoid multiple definitions
\ No newline at end of file
+Move::Move(int fr, int fc, int tr, int tc, PieceType ct,
+    Color cc, bool firstMove, SpecialMoveType special,
+    PieceType promotion)
+    : fromRow(fr), fromCol(fc), toRow(tr), toCol(tc),
+    capturedType(ct), capturedColor(cc), wasFirstMove(firstMove),
+    specialMove(special), promotionPiece(promotion) {
+}
@@ -0,0 +1,69 @@
+#include "Entities/PackedMove.h"
+#include "Entities/Position.h"
+#include "Move.h"
+
+std::string toUciString(PackedMove move) {
+    if (move.isNull()) return "0000";
+
+    std::string uci;
+    uci += static_cast<char>('a' + fileOf(move.from()));
+    uci += static_cast<char>('1' + rankOf(move.from()));
+    uci += static_cast<char>('a' + fileOf(move.to()));
+    uci += static_cast<char>('1' + rankOf(move.to()));
+    if (move.isPromotion()) {
+        uci += "nbrq"[toIndex(move.promotionType()) - toIndex(PieceType::Knight)];
+    }
+    return uci;
+}
+
+Move toLegacyMove(PackedMove move, const Position& position) {
+    int from = move.from();
+    int to = move.to();
+
+    Piece captured = position.pieceOn(to);
+    PieceType capturedType = typeOf(captured);
+    Color capturedColor = colorOf(captured);
+    SpecialMoveType special = SpecialMoveType::None;
+    PieceType promotion = PieceType::None;
+
+    switch (move.flag()) {
+        case EN_PASSANT_MOVE:
+            special = SpecialMoveType::EnPassant;
+            capturedType = PieceType::Pawn;
+            capturedColor = opposite(colorOf(position.pieceOn(from)));
+            break;
+        case CASTLING_MOVE:
+            special = SpecialMoveType::Castling;
+            break;
+        case PROMOTION_MOVE:
+            special = SpecialMoveType::PawnPromotion;
+            promotion = move.promotionType();
+            break;
+        default:
+            break;
+    }
+
+    return Move(rowOf(from), colOf(from), rowOf(to), colOf(to), capturedType, capturedColor,
+                false, special, promotion);
+}
+
+PackedMove toPackedMove(const Move& move, const Position& position) {
+    int from = squareAt(move.fromRow, move.fromCol);
+    int to = squareAt(move.toRow, move.toCol);
+    PieceType type = typeOf(position.pieceOn(from));
+
+    // Le GUI ne renseigne pas toujours specialMove: on déduit le type de coup de la position
+    if (type == PieceType::King && (to - from == 2 || from - to == 2)) {
+        return PackedMove(from, to, CASTLING_MOVE);
+    }
+    if (type == PieceType::Pawn) {
+        if (to == position.enPassantSquare()) {
+            return PackedMove(from, to, EN_PASSANT_MOVE);
+        }
+        PieceType promotion = move.promotionPiece;
+        if (promotion != PieceType::None && (rankOf(to) == 7 || rankOf(to) == 0)) {
+            return PackedMove(from, to, PROMOTION_MOVE, promotion);
+        }
+    }
+    return PackedMove(from, to);
+}
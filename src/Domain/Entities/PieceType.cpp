@@ -0,0 +1,23 @@
+#include "Entities/PieceType.h"
+
+std::string toString(PieceType type) {
+    switch (type) {
+        case PieceType::Pawn: return "pawn";
+        case PieceType::Knight: return "knight";
+        case PieceType::Bishop: return "bishop";
+        case PieceType::Rook: return "rook";
+        case PieceType::Queen: return "queen";
+        case PieceType::King: return "king";
+        default: return "";
+    }
+}
+
+PieceType pieceTypeFromString(const std::string& name) {
+    if (name == "pawn") return PieceType::Pawn;
+    if (name == "knight") return PieceType::Knight;
+    if (name == "bishop") return PieceType::Bishop;
+    if (name == "rook") return PieceType::Rook;
+    if (name == "queen") return PieceType::Queen;
+    if (name == "king") return PieceType::King;
+    return PieceType::None;
+}
@@ -0,0 +1,515 @@
+#include "Entities/Position.h"
+#include <algorithm>
+#include <sstream>
+
+namespace {
+    // Droits de roque conservés quand une pièce part de / arrive sur chaque case
+    struct CastlingMasks {
+        uint8_t mask[SQUARE_COUNT];
+
+        CastlingMasks() {
+            for (int square = 0; square < SQUARE_COUNT; square++) mask[square] = ALL_CASTLING;
+            mask[squareAt(7, 4)] &= ~(WHITE_KINGSIDE | WHITE_QUEENSIDE);
+            mask[squareAt(7, 7)] &= ~WHITE_KINGSIDE;
+            mask[squareAt(7, 0)] &= ~WHITE_QUEENSIDE;
+            mask[squareAt(0, 4)] &= ~(BLACK_KINGSIDE | BLACK_QUEENSIDE);
+            mask[squareAt(0, 7)] &= ~BLACK_KINGSIDE;
+            mask[squareAt(0, 0)] &= ~BLACK_QUEENSIDE;
+        }
+    };
+
+    const CastlingMasks s_castlingMasks;
+
+    // Lettres FEN dans l'ordre des Piece (blancs puis noirs)
+    const char PIECE_CHARS[] = "PNBRQKpnbrqk";
+
+    // Clés Zobrist générées à la compilation (xorshift64*, graine fixe)
+    struct ZobristKeys {
+        uint64_t pieceSquare[PIECE_COUNT][SQUARE_COUNT];
+        uint64_t castling[ALL_CASTLING + 1];  // castling[0] = 0
+        uint64_t enPassantFile[8];
+        uint64_t blackToMove;
+    };
+
+    constexpr ZobristKeys makeZobristKeys() {
+        ZobristKeys keys{};
+        uint64_t state = 1070372ULL;
+        auto next = [&state]() {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 2685821657736338717ULL;
+        };
+
+        for (auto& squares : keys.pieceSquare) {
+            for (uint64_t& key : squares) key = next();
+        }
+        // Une clé par droit, combinées par XOR pour chaque masque
+        uint64_t rightKeys[4] = { next(), next(), next(), next() };
+        for (int rights = 0; rights <= ALL_CASTLING; rights++) {
+            for (int bit = 0; bit < 4; bit++) {
+                if (rights & (1 << bit)) keys.castling[rights] ^= rightKeys[bit];
+            }
+        }
+        for (uint64_t& key : keys.enPassantFile) key = next();
+        keys.blackToMove = next();
+        return keys;
+    }
+
+    constexpr ZobristKeys Zobrist = makeZobristKeys();
+
+    uint64_t enPassantKey(int square) {
+        return square == NO_SQUARE ? 0 : Zobrist.enPassantFile[fileOf(square)];
+    }
+}
+
+Position::Position() {
+    clear();
+}
+
+void Position::clear() {
+    for (Bitboard& bb : m_byType) bb = 0;
+    for (Bitboard& bb : m_byColor) bb = 0;
+    for (Piece& piece : m_board) piece = NO_PIECE;
+    m_sideToMove = Color::White;
+    m_castlingRights = NO_CASTLING;
+    m_enPassantSquare = NO_SQUARE;
+    m_halfMoveClock = 0;
+    m_fullMoveNumber = 1;
+    m_key = 0;
+    m_pawnKey = 0;
+    m_psq = PieceSquare::Score();
+    m_phase = 0;
+}
+
+Position Position::startingPosition() {
+    Position position;
+    const PieceType backRow[8] = {
+        PieceType::Rook, PieceType::Knight, PieceType::Bishop, PieceType::Queen,
+        PieceType::King, PieceType::Bishop, PieceType::Knight, PieceType::Rook
+    };
+    for (int col = 0; col < 8; col++) {
+        position.putPiece(makePiece(Color::Black, backRow[col]), squareAt(0, col));
+        position.putPiece(makePiece(Color::Black, PieceType::Pawn), squareAt(1, col));
+        position.putPiece(makePiece(Color::White, PieceType::Pawn), squareAt(6, col));
+        position.putPiece(makePiece(Color::White, backRow[col]), squareAt(7, col));
+    }
+    position.m_castlingRights = ALL_CASTLING;
+    position.m_key = position.computeKey();
+    return position;
+}
+
+bool Position::setFromFen(const std::string& fen) {
+    std::istringstream stream(fen);
+    std::string placement, side, castling, enPassant;
+    int halfMoves = 0, fullMoves = 1;
+
+    if (!(stream >> placement >> side)) return false;
+    stream >> castling >> enPassant >> halfMoves >> fullMoves;
+
+    clear();
+
+    int rank = 7, file = 0;
+    for (char c : placement) {
+        if (c == '/') {
+            rank--;
+            file = 0;
+        } else if (c >= '1' && c <= '8') {
+            file += c - '0';
+        } else {
+            const char* found = std::char_traits<char>::find(PIECE_CHARS, PIECE_COUNT, c);
+            // Pion sur la première ou la dernière rangée: position impossible, que la
+            // génération de coups ne sait pas traiter (poussée hors de l'échiquier)
+            Piece piece = found ? static_cast<Piece>(found - PIECE_CHARS) : NO_PIECE;
+            if (!found || rank < 0 || file > 7
+                || (typeOf(piece) == PieceType::Pawn && (rank == 0 || rank == 7))) {
+                clear();
+                return false;
+            }
+            putPiece(piece, rank * 8 + file);
+            file++;
+        }
+    }
+
+    m_sideToMove = (side == "b") ? Color::Black : Color::White;
+
+    for (char c : castling) {
+        if (c == 'K') m_castlingRights |= WHITE_KINGSIDE;
+        else if (c == 'Q') m_castlingRights |= WHITE_QUEENSIDE;
+        else if (c == 'k') m_castlingRights |= BLACK_KINGSIDE;
+        else if (c == 'q') m_castlingRights |= BLACK_QUEENSIDE;
+    }
+
+    // Comme dans makeMove: la case n'est gardée que si une prise est possible
+    if (enPassant.size() == 2 && enPassant[0] >= 'a' && enPassant[0] <= 'h'
+        && (enPassant[1] == '3' || enPassant[1] == '6')) {
+        int square = (enPassant[1] - '1') * 8 + (enPassant[0] - 'a');
+        if (Bitboards::pawnAttacks(opposite(m_sideToMove), square) & pieces(m_sideToMove, PieceType::Pawn)) {
+            m_enPassantSquare = static_cast<uint8_t>(square);
+        }
+    }
+
+    m_halfMoveClock = static_cast<uint16_t>(halfMoves);
+    m_fullMoveNumber = static_cast<uint16_t>(fullMoves > 0 ? fullMoves : 1);
+    m_key = computeKey();
+    return true;
+}
+
+std::string Position::toFen() const {
+    std::ostringstream fen;
+    for (int rank = 7; rank >= 0; rank--) {
+        int empty = 0;
+        for (int file = 0; file < 8; file++) {
+            Piece piece = m_board[rank * 8 + file];
+            if (piece == NO_PIECE) {
+                empty++;
+                continue;
+            }
+            if (empty) fen << empty;
+            empty = 0;
+            fen << PIECE_CHARS[piece];
+        }
+        if (empty) fen << empty;
+        if (rank > 0) fen << '/';
+    }
+
+    fen << (m_sideToMove == Color::White ? " w " : " b ");
+    if (m_castlingRights == NO_CASTLING) fen << '-';
+    if (m_castlingRights & WHITE_KINGSIDE) fen << 'K';
+    if (m_castlingRights & WHITE_QUEENSIDE) fen << 'Q';
+    if (m_castlingRights & BLACK_KINGSIDE) fen << 'k';
+    if (m_castlingRights & BLACK_QUEENSIDE) fen << 'q';
+
+    if (m_enPassantSquare == NO_SQUARE) {
+        fen << " -";
+    } else {
+        fen << ' ' << static_cast<char>('a' + fileOf(m_enPassantSquare))
+            << static_cast<char>('1' + rankOf(m_enPassantSquare));
+    }
+    fen << ' ' << m_halfMoveClock << ' ' << m_fullMoveNumber;
+    return fen.str();
+}
+
+void Position::putPiece(Piece piece, int square) {
+    if (piece == NO_PIECE) return;
+    if (m_board[square] != NO_PIECE) removePiece(square);
+    Bitboard bb = squareBB(square);
+    m_byType[toIndex(typeOf(piece))] |= bb;
+    m_byColor[toIndex(colorOf(piece))] |= bb;
+    m_board[square] = piece;
+    m_key ^= Zobrist.pieceSquare[piece][square];
+    if (typeOf(piece) == PieceType::Pawn) m_pawnKey ^= Zobrist.pieceSquare[piece][square];
+    m_psq += PieceSquare::value(piece, square);
+    m_phase += PieceSquare::phaseWeight(piece);
+}
+
+void Position::removePiece(int square) {
+    Piece piece = m_board[square];
+    if (piece == NO_PIECE) return;
+    Bitboard bb = squareBB(square);
+    m_byType[toIndex(typeOf(piece))] &= ~bb;
+    m_byColor[toIndex(colorOf(piece))] &= ~bb;
+    m_board[square] = NO_PIECE;
+    m_key ^= Zobrist.pieceSquare[piece][square];
+    if (typeOf(piece) == PieceType::Pawn) m_pawnKey ^= Zobrist.pieceSquare[piece][square];
+    m_psq -= PieceSquare::value(piece, square);
+    m_phase -= PieceSquare::phaseWeight(piece);
+}
+
+void Position::movePiece(int from, int to) {
+    Piece piece = m_board[from];
+    if (piece == NO_PIECE) return;
+    Bitboard fromTo = squareBB(from) | squareBB(to);
+    m_byType[toIndex(typeOf(piece))] ^= fromTo;
+    m_byColor[toIndex(colorOf(piece))] ^= fromTo;
+    m_board[to] = piece;
+    m_board[from] = NO_PIECE;
+    m_key ^= Zobrist.pieceSquare[piece][from] ^ Zobrist.pieceSquare[piece][to];
+    if (typeOf(piece) == PieceType::Pawn) {
+        m_pawnKey ^= Zobrist.pieceSquare[piece][from] ^ Zobrist.pieceSquare[piece][to];
+    }
+    m_psq -= PieceSquare::value(piece, from);
+    m_psq += PieceSquare::value(piece, to);
+}
+
+void Position::makeMove(PackedMove move, StateInfo& state) {
+    int from = move.from();
+    int to = move.to();
+    Piece piece = m_board[from];
+    Color us = colorOf(piece);
+    PieceType type = typeOf(piece);
+
+    state.key = m_key;
+    state.castlingRights = m_castlingRights;
+    state.enPassantSquare = m_enPassantSquare;
+    state.halfMoveClock = m_halfMoveClock;
+    state.capturedPiece = m_board[to];
+    state.dirtyCount = 0;
+
+    // Retirer de la clé l'ancien état; le nouvel état est ajouté en fin de coup
+    m_key ^= Zobrist.castling[m_castlingRights] ^ enPassantKey(m_enPassantSquare);
+
+    if (move.flag() == EN_PASSANT_MOVE) {
+        // Prise en passant: le pion capturé est derrière la case d'arrivée
+        int capturedSquare = (us == Color::White) ? to - 8 : to + 8;
+        state.capturedPiece = m_board[capturedSquare];
+        state.dirty[state.dirtyCount++] = { state.capturedPiece, static_cast<uint8_t>(capturedSquare), NO_SQUARE };
+        removePiece(capturedSquare);
+    } else if (state.capturedPiece != NO_PIECE) {
+        state.dirty[state.dirtyCount++] = { state.capturedPiece, static_cast<uint8_t>(to), NO_SQUARE };
+        removePiece(to);
+    }
+
+    movePiece(from, to);
+
+    if (move.flag() == CASTLING_MOVE) {
+        // Roque: déplacer aussi la tour
+        bool kingside = to > from;
+        int rookFrom = kingside ? to + 1 : to - 2;
+        int rookTo = kingside ? to - 1 : to + 1;
+        state.dirty[state.dirtyCount++] = { piece, static_cast<uint8_t>(from), static_cast<uint8_t>(to) };
+        state.dirty[state.dirtyCount++] = { m_board[rookFrom], static_cast<uint8_t>(rookFrom), static_cast<uint8_t>(rookTo) };
+        movePiece(rookFrom, rookTo);
+    } else if (move.flag() == PROMOTION_MOVE) {
+        Piece promoted = makePiece(us, move.promotionType());
+        state.dirty[state.dirtyCount++] = { piece, static_cast<uint8_t>(from), NO_SQUARE };
+        state.dirty[state.dirtyCount++] = { promoted, NO_SQUARE, static_cast<uint8_t>(to) };
+        removePiece(to);
+        putPiece(promoted, to);
+    } else {
+        state.dirty[state.dirtyCount++] = { piece, static_cast<uint8_t>(from), static_cast<uint8_t>(to) };
+    }
+
+    m_castlingRights &= s_castlingMasks.mask[from] & s_castlingMasks.mask[to];
+
+    // Case de prise en passant seulement si un pion adverse peut réellement prendre
+    m_enPassantSquare = NO_SQUARE;
+    if (type == PieceType::Pawn && (to - from == 16 || from - to == 16)) {
+        int passed = (from + to) / 2;
+        if (Bitboards::pawnAttacks(us, passed) & pieces(opposite(us), PieceType::Pawn)) {
+            m_enPassantSquare = static_cast<uint8_t>(passed);
+        }
+    }
+
+    bool isCapture = state.capturedPiece != NO_PIECE;
+    m_halfMoveClock = (type == PieceType::Pawn || isCapture) ? 0 : m_halfMoveClock + 1;
+    if (us == Color::Black) m_fullMoveNumber++;
+    m_sideToMove = opposite(us);
+
+    m_key ^= Zobrist.castling[m_castlingRights] ^ enPassantKey(m_enPassantSquare) ^ Zobrist.blackToMove;
+}
+
+void Position::unmakeMove(PackedMove move, const StateInfo& state) {
+    int from = move.from();
+    int to = move.to();
+    Color us = opposite(m_sideToMove);
+    m_sideToMove = us;
+    if (us == Color::Black) m_fullMoveNumber--;
+
+    if (move.flag() == PROMOTION_MOVE) {
+        removePiece(to);
+        putPiece(makePiece(us, PieceType::Pawn), to);
+    }
+
+    movePiece(to, from);
+
+    if (move.flag() == CASTLING_MOVE) {
+        bool kingside = to > from;
+        movePiece(kingside ? to - 1 : to + 1, kingside ? to + 1 : to - 2);
+    }
+
+    if (state.capturedPiece != NO_PIECE) {
+        int capturedSquare = to;
+        if (move.flag() == EN_PASSANT_MOVE) {
+            capturedSquare = (us == Color::White) ? to - 8 : to + 8;
+        }
+        putPiece(state.capturedPiece, capturedSquare);
+    }
+
+    m_castlingRights = state.castlingRights;
+    m_enPassantSquare = state.enPassantSquare;
+    m_halfMoveClock = state.halfMoveClock;
+    m_key = state.key;
+}
+
+void Position::makeNullMove(StateInfo& state) {
+    state.key = m_key;
+    state.castlingRights = m_castlingRights;
+    state.enPassantSquare = m_enPassantSquare;
+    state.halfMoveClock = m_halfMoveClock;
+    state.capturedPiece = NO_PIECE;
+    state.dirtyCount = 0;
+
+    m_key ^= enPassantKey(m_enPassantSquare) ^ Zobrist.blackToMove;
+    m_enPassantSquare = NO_SQUARE;
+    // Une répétition ne doit pas être détectée à travers un coup nul
+    m_halfMoveClock = 0;
+    m_sideToMove = opposite(m_sideToMove);
+}
+
+void Position::unmakeNullMove(const StateInfo& state) {
+    m_sideToMove = opposite(m_sideToMove);
+    m_enPassantSquare = state.enPassantSquare;
+    m_halfMoveClock = state.halfMoveClock;
+    m_key = state.key;
+}
+
+void Position::applyMove(PackedMove move) {
+    if (m_board[move.from()] == NO_PIECE) return;
+    StateInfo state;
+    makeMove(move, state);
+}
+
+void Position::setSideToMove(Color color) {
+    if (color != m_sideToMove) m_key ^= Zobrist.blackToMove;
+    m_sideToMove = color;
+}
+
+void Position::setCastlingRights(uint8_t rights) {
+    m_key ^= Zobrist.castling[m_castlingRights] ^ Zobrist.castling[rights];
+    m_castlingRights = rights;
+}
+
+void Position::setEnPassantSquare(int square) {
+    m_key ^= enPassantKey(m_enPassantSquare) ^ enPassantKey(square);
+    m_enPassantSquare = static_cast<uint8_t>(square);
+}
+
+uint64_t Position::computeKey() const {
+    uint64_t key = 0;
+    for (int square = 0; square < SQUARE_COUNT; square++) {
+        if (m_board[square] != NO_PIECE) key ^= Zobrist.pieceSquare[m_board[square]][square];
+    }
+    key ^= Zobrist.castling[m_castlingRights] ^ enPassantKey(m_enPassantSquare);
+    if (m_sideToMove == Color::Black) key ^= Zobrist.blackToMove;
+    return key;
+}
+
+void Position::setCastlingRightsFromPlacement() {
+    uint8_t rights = NO_CASTLING;
+    auto has = [this](int row, int col, Color color, PieceType type) {
+        return m_board[squareAt(row, col)] == makePiece(color, type);
+    };
+    if (has(7, 4, Color::White, PieceType::King)) {
+        if (has(7, 7, Color::White, PieceType::Rook)) rights |= WHITE_KINGSIDE;
+        if (has(7, 0, Color::White, PieceType::Rook)) rights |= WHITE_QUEENSIDE;
+    }
+    if (has(0, 4, Color::Black, PieceType::King)) {
+        if (has(0, 7, Color::Black, PieceType::Rook)) rights |= BLACK_KINGSIDE;
+        if (has(0, 0, Color::Black, PieceType::Rook)) rights |= BLACK_QUEENSIDE;
+    }
+    setCastlingRights(rights);
+}
+
+int Position::kingSquare(Color color) const {
+    Bitboard king = pieces(color, PieceType::King);
+    return king ? lsb(king) : NO_SQUARE;
+}
+
+Bitboard Position::attackersTo(int square, Bitboard occupied) const {
+    Bitboard rookLike = pieces(PieceType::Rook) | pieces(PieceType::Queen);
+    Bitboard bishopLike = pieces(PieceType::Bishop) | pieces(PieceType::Queen);
+
+    return (Bitboards::pawnAttacks(Color::Black, square) & pieces(Color::White, PieceType::Pawn))
+         | (Bitboards::pawnAttacks(Color::White, square) & pieces(Color::Black, PieceType::Pawn))
+         | (Bitboards::knightAttacks(square) & pieces(PieceType::Knight))
+         | (Bitboards::kingAttacks(square) & pieces(PieceType::King))
+         | (Bitboards::rookAttacks(square, occupied) & rookLike)
+         | (Bitboards::bishopAttacks(square, occupied) & bishopLike);
+}
+
+bool Position::isSquareAttacked(int square, Color attacker) const {
+    return (attackersTo(square, pieces()) & pieces(attacker)) != 0;
+}
+
+bool Position::isInCheck(Color color) const {
+    int king = kingSquare(color);
+    return king != NO_SQUARE && isSquareAttacked(king, opposite(color));
+}
+
+namespace {
+    // Valeurs de l'échange statique (le roi ne peut jamais être « pris »)
+    constexpr int SEE_VALUES[PIECE_TYPE_COUNT] = { 100, 300, 300, 500, 900, 20000 };
+}
+
+int Position::staticExchange(PackedMove move) const {
+    int from = move.from();
+    int to = move.to();
+    if (move.flag() == CASTLING_MOVE) return 0;
+
+    Piece mover = m_board[from];
+    if (mover == NO_PIECE) return 0;
+
+    Color us = colorOf(mover);
+    Bitboard occupied = pieces() ^ squareBB(from);
+    int gain[32];
+    int depth = 0;
+
+    if (move.flag() == EN_PASSANT_MOVE) {
+        occupied ^= squareBB((from & ~7) | (to & 7));
+        gain[0] = SEE_VALUES[toIndex(PieceType::Pawn)];
+    } else {
+        gain[0] = m_board[to] == NO_PIECE ? 0 : SEE_VALUES[toIndex(typeOf(m_board[to]))];
+    }
+
+    // Valeur de la pièce posée sur la case, que le camp adverse peut reprendre
+    int onSquare = SEE_VALUES[toIndex(typeOf(mover))];
+    if (move.isPromotion()) {
+        int promoted = SEE_VALUES[toIndex(move.promotionType())];
+        gain[0] += promoted - SEE_VALUES[toIndex(PieceType::Pawn)];
+        onSquare = promoted;
+    }
+
+    Bitboard rookLike = pieces(PieceType::Rook) | pieces(PieceType::Queen);
+    Bitboard bishopLike = pieces(PieceType::Bishop) | pieces(PieceType::Queen);
+    Bitboard attackers = attackersTo(to, occupied) & occupied;
+    Color side = opposite(us);
+
+    while (depth < 31) {
+        Bitboard ours = attackers & pieces(side);
+        if (!ours) break;
+
+        // Attaquant le moins cher
+        PieceType type = PieceType::Pawn;
+        Bitboard candidates = 0;
+        for (int t = toIndex(PieceType::Pawn); t <= toIndex(PieceType::King); t++) {
+            candidates = ours & m_byType[t];
+            if (candidates) {
+                type = static_cast<PieceType>(t);
+                break;
+            }
+        }
+
+        // Le roi ne prend pas une pièce encore défendue
+        if (type == PieceType::King && (attackers & pieces(opposite(side)))) break;
+
+        depth++;
+        gain[depth] = onSquare - gain[depth - 1];
+        onSquare = SEE_VALUES[toIndex(type)];
+
+        // Élagage: le camp qui vient de prendre perd de toute façon, la suite ne change rien
+        if (std::max(-gain[depth - 1], gain[depth]) < 0) {
+            depth--;
+            break;
+        }
+
+        occupied ^= squareBB(lsb(candidates));
+
+        // Rayons X: les pièces glissantes derrière l'attaquant retiré entrent en jeu
+        if (type == PieceType::Pawn || type == PieceType::Bishop || type == PieceType::Queen) {
+            attackers |= Bitboards::bishopAttacks(to, occupied) & bishopLike;
+        }
+        if (type == PieceType::Rook || type == PieceType::Queen) {
+            attackers |= Bitboards::rookAttacks(to, occupied) & rookLike;
+        }
+        attackers &= occupied;
+        side = opposite(side);
+    }
+
+    // Chaque camp choisit de poursuivre l'échange ou de s'arrêter
+    while (depth > 0) {
+        depth--;
+        gain[depth] = -std::max(-gain[depth], gain[depth + 1]);
+    }
+    return gain[0];
+}
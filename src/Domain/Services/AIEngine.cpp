@@ -1,11 +1,140 @@
 #include "AIEngine.h"
-#include "ChessBoard.h"
+#include "Entities/Position.h"
 #include "Rules/MoveValidator.h"
+#include "EndgameBitbases.h"
 #include "Evaluator.h"
+#include "MoveGenerator.h"
+#include "Nnue.h"
+#include "OpeningBook.h"
+#include "ParallelSearch.h"
+#include "PackedMove.h"
 #include <random>
 #include <algorithm>
+#include <chrono>
 #include <limits>
 #include <iostream>
+#include <cstdlib>
+#include <string>
+
+// Recherche asynchrone commune à tous les moteurs
+
+template <typename Result, typename Task>
+std::future<Result> AIEngine::launch(Task task, bool pondering) {
+    cancelSearch();
+    m_pondering = pondering;
+    {
+        std::lock_guard<std::mutex> lock(m_progressMutex);
+        m_progress = SearchProgress();
+    }
+
+    auto promise = std::make_shared<std::promise<Result>>();
+    std::future<Result> result = promise->get_future();
+    m_searching = true;
+    m_worker = std::thread([this, promise, task = std::move(task)]() {
+        // Les indicateurs sont remis à zéro avant que le futur ne devienne prêt
+        try {
+            Result value = task();
+            m_stopRequested = false;
+            m_pondering = false;
+            m_searching = false;
+            promise->set_value(std::move(value));
+        } catch (...) {
+            m_stopRequested = false;
+            m_pondering = false;
+            m_searching = false;
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return result;
+}
+
+std::future<Move> AIEngine::startSearch(const Position& position, Color color) {
+    return launch<Move>([this, snapshot = position, color]() { return chooseMove(snapshot, color); });
+}
+
+std::future<SearchProgress> AIEngine::startAnalysis(const Position& position, int lineCount) {
+    return launch<SearchProgress>([this, snapshot = position, lineCount]() { return analyze(snapshot, lineCount); });
+}
+
+std::future<Move> AIEngine::startPondering(const Position& position, Color color) {
+    cancelSearch();
+    PackedMove reply = expectedReply();
+    MoveList moves;
+    MoveGenerator(position).generateLegalMoves(position.sideToMove(), moves);
+    if (reply.isNull() || position.sideToMove() == color || !moves.contains(reply)) return std::future<Move>();
+
+    Position expected = position;
+    StateInfo state;
+    expected.makeMove(reply, state);
+    std::future<Move> result = launch<Move>([this, expected, color]() { return ponder(expected, color); }, true);
+    m_ponderKey = expected.key();
+    m_ponderMove = reply;
+    return result;
+}
+
+bool AIEngine::ponderHit(const Position& position) {
+    if (m_ponderKey == 0 || position.key() != m_ponderKey) return false;
+    m_ponderKey = 0;
+    m_pondering = false;
+    return true;
+}
+
+void AIEngine::setProgressListener(ProgressListener listener) {
+    std::lock_guard<std::mutex> lock(m_progressMutex);
+    m_progressListener = std::move(listener);
+}
+
+void AIEngine::stopSearch() {
+    if (m_searching) m_stopRequested = true;
+}
+
+void AIEngine::cancelSearch() {
+    stopSearch();
+    if (m_worker.joinable()) m_worker.join();
+    m_stopRequested = false;
+    m_ponderKey = 0;
+    m_ponderMove = PackedMove();
+}
+
+SearchProgress AIEngine::getProgress() const {
+    std::lock_guard<std::mutex> lock(m_progressMutex);
+    return m_progress;
+}
+
+void AIEngine::publishProgress(const SearchProgress& progress) {
+    ProgressListener listener;
+    {
+        std::lock_guard<std::mutex> lock(m_progressMutex);
+        m_progress = progress;
+        listener = m_progressListener;
+    }
+    if (listener) listener(progress);
+}
+
+AIEngine::~AIEngine() {
+    cancelSearch();
+}
+
+void AIEngine::setOpeningBook(std::shared_ptr<const OpeningBook> book, double sharpness) {
+    m_book = book && book->isOpen() ? std::move(book) : nullptr;
+    m_bookSharpness = sharpness;
+}
+
+bool AIEngine::probeBook(const Position& position, Color color, Move& move) {
+    if (!m_book) return false;
+
+    auto start = std::chrono::steady_clock::now();
+    Position root = position;
+    if (root.sideToMove() != color) root.setSideToMove(color);
+    PackedMove bookMove = m_book->pickMove(root, m_bookRng, m_bookSharpness);
+    if (bookMove.isNull()) return false;
+
+    move = toLegacyMove(bookMove, root);
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "[OpeningBook] " << toString(color) << " book move " << toUciString(bookMove)
+              << " (" << micros.count() << " us)" << std::endl;
+    return true;
+}
 
 // RandomAI - Niveau Facile
 class RandomAI : public AIEngine {
@@ -18,12 +147,16 @@ public:
         std::cout << "[RandomAI] Initialized - Easy difficulty" << std::endl;
     }
     
-    Move chooseMove(const ChessBoard& board, const std::string& playerColor) override {
-        MoveValidator validator(&board);
-        std::vector<Move> validMoves = validator.getAllValidMovesForColor(playerColor);
+    ~RandomAI() override {
+        cancelSearch();
+    }
+    
+    Move chooseMove(const Position& position, Color color) override {
+        MoveValidator validator(&position);
+        std::vector<Move> validMoves = validator.getAllValidMovesForColor(color);
         
         if (validMoves.empty()) {
-            std::cout << "[RandomAI] " << playerColor << " - No valid moves available!" << std::endl;
+            std::cout << "[RandomAI] " << toString(color) << " - No valid moves available!" << std::endl;
             return Move(-1, -1, -1, -1);
         }
         
@@ -32,7 +165,7 @@ public:
         Move chosenMove = validMoves[randomIndex];
         
         // LOG OPTIMISÉ : Une seule ligne par décision
-        std::cout << "[RandomAI] " << playerColor << " examined " << validMoves.size() 
+        std::cout << "[RandomAI] " << toString(color) << " examined " << validMoves.size() 
                   << " moves, chose random move: (" << chosenMove.fromRow << "," << chosenMove.fromCol 
                   << ") → (" << chosenMove.toRow << "," << chosenMove.toCol << ")" << std::endl;
         
@@ -47,12 +180,19 @@ public:
         std::cout << "[HeuristicAI] Initialized - Medium difficulty" << std::endl;
     }
     
-    Move chooseMove(const ChessBoard& board, const std::string& playerColor) override {
-        MoveValidator validator(&board);
-        std::vector<Move> validMoves = validator.getAllValidMovesForColor(playerColor);
+    ~HeuristicAI() override {
+        cancelSearch();
+    }
+    
+    Move chooseMove(const Position& position, Color color) override {
+        Move bookMove(-1, -1, -1, -1);
+        if (probeBook(position, color, bookMove)) return bookMove;
+
+        MoveValidator validator(&position);
+        std::vector<Move> validMoves = validator.getAllValidMovesForColor(color);
         
         if (validMoves.empty()) {
-            std::cout << "[HeuristicAI] " << playerColor << " - No valid moves available!" << std::endl;
+            std::cout << "[HeuristicAI] " << toString(color) << " - No valid moves available!" << std::endl;
             return Move(-1, -1, -1, -1);
         }
         
@@ -62,7 +202,7 @@ public:
         
         // Évaluation silencieuse de tous les coups
         for (const Move& move : validMoves) {
-            double score = evaluateMove(board, move, playerColor);
+            double score = evaluateMove(position, move, color);
             
             if (score > bestScore) {
                 bestScore = score;
@@ -70,19 +210,19 @@ public:
             }
             
             // Compter les captures pour le log
-            if (!move.capturedType.empty()) {
+            if (move.isCapture()) {
                 captureCount++;
             }
         }
         
         // LOG OPTIMISÉ : Résumé concis de l'analyse
-        std::cout << "[HeuristicAI] " << playerColor << " analyzed " << validMoves.size() 
+        std::cout << "[HeuristicAI] " << toString(color) << " analyzed " << validMoves.size() 
                   << " moves (" << captureCount << " captures), best score: " << bestScore 
                   << ", chose: (" << bestMove.fromRow << "," << bestMove.fromCol 
                   << ") → (" << bestMove.toRow << "," << bestMove.toCol << ")";
         
-        if (!bestMove.capturedType.empty()) {
-            std::cout << " [CAPTURE " << bestMove.capturedType << "]";
+        if (bestMove.isCapture()) {
+            std::cout << " [CAPTURE " << toString(bestMove.capturedType) << "]";
         }
         std::cout << std::endl;
         
@@ -90,129 +230,194 @@ public:
     }
     
 private:
-    double evaluateMove(const ChessBoard& board, const Move& move, const std::string& playerColor) {
+    double evaluateMove(const Position& position, const Move& move, Color color) {
         double score = 0.0;
         
-        // Bonus pour capturer une pièce
-        if (!move.capturedType.empty()) {
-            score += Evaluator::getPieceValue(move.capturedType) * 10.0;
-        }
+        // Bilan matériel de l'échange sur la case d'arrivée (SEE): une prise défendue
+        // ou une pièce posée en prise est pénalisée, au lieu de compter la seule victime
+        double exchange = position.staticExchange(toPackedMove(move, position)) / 100.0;
+        score += exchange * 10.0;
         
         // Bonus pour se rapprocher du centre
         double centerDistance = std::abs(move.toRow - 3.5) + std::abs(move.toCol - 3.5);
         score += (7 - centerDistance) * 0.1;
         
         // Évaluation de la position actuelle
-        score += Evaluator::evaluatePosition(board, playerColor);
+        score += Evaluator::evaluatePosition(position, color);
         
         return score;
     }
 };
 
 // MinimaxAI  Niveau Difficile
+// Recherche negamax alpha-bêta réelle (voir Search). Avec une pendule, l'approfondissement
+// itératif s'arrête selon le budget de temps; sinon à maxDepth.
 
 class MinimaxAI : public AIEngine {
 private:
     int maxDepth;
+    uint64_t maxNodes;    // 0 = illimité
+    double clockSeconds;  // Temps restant à la pendule (0 = partie sans pendule)
+    TranspositionTable table;  // Conservée d'un coup à l'autre
+    ParallelSearch search;     // Lazy SMP, un seul thread par défaut
+    std::unique_ptr<Nnue::Network> network;  // nullptr: évaluation classique
+    std::shared_ptr<const EndgameBitbases> bitbases;
+    PackedMove reply;          // Deuxième coup de la dernière variation: réponse attendue (ponder)
+    std::vector<uint64_t> gameKeys;  // Positions de la partie, la courante en dernier (répétitions)
+    
+    static SearchProgress toProgress(const SearchResult& result) {
+        SearchProgress progress;
+        progress.depth = result.depth;
+        progress.selDepth = result.selDepth;
+        progress.score = scoreToString(result.score);
+        progress.pv = result.pvString();
+        progress.nodes = result.nodes;
+        progress.nodesPerSecond = result.nodesPerSecond();
+        progress.seconds = result.seconds;
+        for (const SearchLine& line : result.lines) {
+            progress.lines.push_back({ scoreToString(line.score), line.pvString() });
+        }
+        return progress;
+    }
     
 public:
-    explicit MinimaxAI(int depth = 3) : maxDepth(depth) {
+    explicit MinimaxAI(int depth = 4, uint64_t nodeLimit = 0)
+        : maxDepth(depth), maxNodes(nodeLimit), clockSeconds(0.0), search(table) {
+        // stopSearch() interrompt la recherche; chaque itération terminée est publiée
+        search.setAbortSignal(&stopSignal());
+        search.setPonderSignal(&ponderSignal());
+        search.setProgressCallback([this](const SearchResult& result) {
+            publishProgress(toProgress(result));
+        });
         std::cout << "[MinimaxAI] Initialized - Hard difficulty (depth " << depth << ")" << std::endl;
     }
     
-    Move chooseMove(const ChessBoard& board, const std::string& playerColor) override {
-        MoveValidator validator(&board);
-        std::vector<Move> validMoves = validator.getAllValidMovesForColor(playerColor);
-        
-        if (validMoves.empty()) {
-            std::cout << "[MinimaxAI] " << playerColor << " - No valid moves available!" << std::endl;
-            return Move(-1, -1, -1, -1);
-        }
-        
-        Move bestMove = validMoves[0];
-        double bestScore = std::numeric_limits<double>::lowest();
-        int captureCount = 0;
-        int centerMoves = 0;
-        int developmentMoves = 0;
-        
-        // Analyse silencieuse avec compteurs
-        for (const Move& move : validMoves) {
-            double score = evaluateAdvancedMove(board, move, playerColor);
-            
-            if (score > bestScore) {
-                bestScore = score;
-                bestMove = move;
-            }
-            
-            // Statistiques pour le log
-            if (!move.capturedType.empty()) captureCount++;
-            if ((move.toRow >= 2 && move.toRow <= 5) && (move.toCol >= 2 && move.toCol <= 5)) centerMoves++;
-            
-            const ChessPiece* piece = board.getPieceAt(move.fromRow, move.fromCol);
-            if (piece && (piece->type == "knight" || piece->type == "bishop")) {
-                bool isInitialPos = (piece->color == "white" && move.fromRow == 7) || 
-                                   (piece->color == "black" && move.fromRow == 0);
-                if (isInitialPos) developmentMoves++;
-            }
+    ~MinimaxAI() override {
+        cancelSearch();
+    }
+    
+    void setClockTime(double remainingSeconds) override {
+        clockSeconds = remainingSeconds;
+    }
+    
+    void setHashSize(size_t megabytes) override {
+        table.resize(megabytes);
+    }
+    
+    void setThreadCount(int threadCount) override {
+        search.setThreadCount(threadCount);
+        std::cout << "[MinimaxAI] Search threads: " << search.threadCount() << std::endl;
+    }
+    
+    bool setEvalFile(const std::string& path) override {
+        // Les threads de recherche lisent le réseau: pas de changement en pleine recherche
+        cancelSearch();
+        if (path.empty()) {
+            search.setNetwork(nullptr);
+            network.reset();
+            std::cout << "[MinimaxAI] Evaluation: hand-crafted" << std::endl;
+            return true;
         }
-        
-        // LOG OPTIMISÉ : Analyse tactique résumée
-        std::cout << "[MinimaxAI] " << playerColor << " deep analysis: " << validMoves.size() 
-                  << " moves [" << captureCount << " captures, " << centerMoves 
-                  << " center, " << developmentMoves << " development], score: " << bestScore 
-                  << ", selected: (" << bestMove.fromRow << "," << bestMove.fromCol 
-                  << ") → (" << bestMove.toRow << "," << bestMove.toCol << ")";
-        
-        if (!bestMove.capturedType.empty()) {
-            std::cout << " [TACTICAL CAPTURE: " << bestMove.capturedType << "]";
+
+        auto loaded = std::make_unique<Nnue::Network>();
+        if (!loaded->load(path)) {
+            std::cout << "[MinimaxAI] Evaluation: keeping " << (network ? "NNUE " + network->path() : "hand-crafted")
+                      << std::endl;
+            return false;
         }
-        std::cout << std::endl;
-        
-        return bestMove;
+        search.setNetwork(loaded.get());
+        network = std::move(loaded);
+        std::cout << "[MinimaxAI] Evaluation: NNUE " << network->path() << std::endl;
+        return true;
     }
     
-private:
-    double evaluateAdvancedMove(const ChessBoard& board, const Move& move, const std::string& playerColor) {
-        double score = 0.0;
+    void setBitbases(std::shared_ptr<const EndgameBitbases> shared) override {
+        // Comme le réseau: lues par les threads de recherche
+        cancelSearch();
+        bitbases = std::move(shared);
+        search.setBitbases(bitbases.get());
+    }
+    
+    void setGameHistory(const std::vector<uint64_t>& keys) override {
+        // Comme le réseau: lues par les threads de recherche
+        cancelSearch();
+        gameKeys = keys;
+    }
+    
+    Move chooseMove(const Position& position, Color color) override {
+        return searchMove(position, color, false);
+    }
+    
+    // Positions de la partie avant root: toutes en ponder (root suit la réponse attendue),
+    // sinon sans la dernière, qui est root elle-même
+    std::vector<uint64_t> historyBefore(const Position& root) const {
+        std::vector<uint64_t> history = gameKeys;
+        if (!history.empty() && history.back() == root.key()) history.pop_back();
+        return history;
+    }
+    
+    Move searchMove(const Position& position, Color color, bool pondering) {
+        reply = PackedMove();
+        Move bookMove(-1, -1, -1, -1);
+        if (probeBook(position, color, bookMove)) return bookMove;
+
+        // La recherche joue pour le camp au trait
+        Position root = position;
+        if (root.sideToMove() != color) root.setSideToMove(color);
+
+        // En ponder, la pendule de l'IA est arrêtée: son budget ne sert qu'après ponderHit()
+        SearchLimits limits;
+        if (clockSeconds > 0.0) {
+            limits = SearchLimits::fromClock(clockSeconds);
+        } else {
+            limits.depth = maxDepth;
+        }
+        limits.nodes = maxNodes;
+        limits.ponder = pondering;
+        SearchResult result = search.run(root, limits, historyBefore(root));
         
-        // 1. Bonus capture (plus important que HeuristicAI)
-        if (!move.capturedType.empty()) {
-            score += Evaluator::getPieceValue(move.capturedType) * 15.0;
+        if (result.bestMove.isNull()) {
+            std::cout << "[MinimaxAI] " << toString(color) << " - No valid moves available!" << std::endl;
+            return Move(-1, -1, -1, -1);
         }
         
-        // 2. Évaluation position actuelle
-        double positionScore = Evaluator::evaluatePosition(board, playerColor);
-        score += positionScore;
+        Move bestMove = toLegacyMove(result.bestMove, root);
+        if (result.pv.size() > 1) reply = result.pv[1];
         
-        // 3. Bonus pour contrôle du centre
-        double centerBonus = 0.0;
-        if ((move.toRow >= 3 && move.toRow <= 4) && (move.toCol >= 3 && move.toCol <= 4)) {
-            centerBonus = 2.0;
-        } else if ((move.toRow >= 2 && move.toRow <= 5) && (move.toCol >= 2 && move.toCol <= 5)) {
-            centerBonus = 1.0;
-        }
-        score += centerBonus;
-        
-        // 4. Bonus développement des pièces
-        const ChessPiece* piece = board.getPieceAt(move.fromRow, move.fromCol);
-        if (piece && !piece->type.empty()) {
-            if (piece->type == "knight" || piece->type == "bishop") {
-                bool isInitialPosition = false;
-                if (piece->color == "white" && move.fromRow == 7) isInitialPosition = true;
-                if (piece->color == "black" && move.fromRow == 0) isInitialPosition = true;
-                
-                if (isInitialPosition) {
-                    score += 1.5;
-                }
-            }
-        }
+        // LOG OPTIMISÉ : Résumé de la recherche sur une ligne
+        std::cout << "[MinimaxAI] " << toString(color) << (pondering ? " (ponder)" : "") << " depth " << result.depth
+                  << " (" << search.threadCount() << " thread" << (search.threadCount() > 1 ? "s" : "") << ")"
+                  << (result.aborted ? " (interrupted)" : "") << ", score: " << scoreToString(result.score)
+                  << ", time: " << static_cast<int>(result.seconds * 1000) << " ms"
+                  << ", nodes: " << result.nodes << ", " << result.nodesPerSecond() << " nps"
+                  << ", tt hits: " << static_cast<int>(result.tt.hitRate() * 100) << "%"
+                  << ", hashfull: " << result.hashfull << "/1000"
+                  << ", pv: " << result.pvString() << std::endl;
         
-        // 5. Pénalité pour exposer le roi
-        if (piece && piece->type == "king") {
-            score -= 1.0;
-        }
+        return bestMove;
+    }
+    
+protected:
+    PackedMove expectedReply() const override {
+        return reply;
+    }
+    
+    Move ponder(const Position& position, Color color) override {
+        return searchMove(position, color, true);
+    }
+    
+    SearchProgress analyze(const Position& position, int lineCount) override {
+        // Jusqu'à stopSearch(): ni pendule, ni limite de noeuds
+        SearchLimits limits;
+        limits.depth = MAX_PLY - 1;
+        limits.multiPV = lineCount;
+        limits.infinite = true;
+        SearchResult result = search.run(position, limits, historyBefore(position));
         
-        return score;
+        std::cout << "[MinimaxAI] Analysis depth " << result.depth << ", " << result.lines.size() << " line"
+                  << (result.lines.size() > 1 ? "s" : "") << ", nodes: " << result.nodes
+                  << ", " << result.nodesPerSecond() << " nps" << std::endl;
+        return toProgress(result);
     }
 };
 
@@ -220,13 +425,30 @@ private:
 std::unique_ptr<AIEngine> createAIEngine(int difficulty) {
     std::cout << "[AIFactory] Creating AI engine for difficulty level " << difficulty << std::endl;
     
+    // Livre projeté en mémoire: l'ouvrir à chaque partie ne coûte presque rien
+    auto openBook = []() -> std::shared_ptr<const OpeningBook> {
+        auto book = std::make_shared<OpeningBook>();
+        if (!book->open(DEFAULT_BOOK_FILE)) return nullptr;
+        return book;
+    };
+
     switch (difficulty) {
         case 1:
             return std::make_unique<RandomAI>();
-        case 2:
-            return std::make_unique<HeuristicAI>();
+        case 2: {
+            // Coups du livre au prorata de leurs poids: ouvertures variées
+            auto engine = std::make_unique<HeuristicAI>();
+            engine->setOpeningBook(openBook(), 1.0);
+            return engine;
+        }
         case 3:
-        default:
-            return std::make_unique<MinimaxAI>(3);
+        default: {
+            // Lignes principales nettement favorisées
+            auto engine = std::make_unique<MinimaxAI>(4);
+            engine->setEvalFile(DEFAULT_EVAL_FILE);
+            engine->setOpeningBook(openBook(), 2.0);
+            engine->setBitbases(EndgameBitbases::openShared(DEFAULT_BITBASE_DIR));
+            return engine;
+        }
     }
 }
\ No newline at end of file
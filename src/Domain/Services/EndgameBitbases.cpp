@@ -0,0 +1,852 @@
+#include "EndgameBitbases.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace {
+    // Valeurs pendant la génération; les tables terminées gardent WIN, LOSS, DRAW sur deux bits
+    constexpr uint8_t UNKNOWN = 0;
+    constexpr uint8_t WIN = 1;
+    constexpr uint8_t LOSS = 2;
+    constexpr uint8_t DRAW = 3;
+    constexpr uint8_t ILLEGAL = 4;
+    constexpr uint8_t NO_TABLE = 5;  // Réponse de lookup(): position hors des tables
+
+    constexpr char MAGIC[4] = { 'C', 'M', 'B', 'B' };
+    constexpr int MATERIAL_NAME_SIZE = 8;
+    constexpr const char* FILE_EXTENSION = ".bb";
+    constexpr uint64_t GENERATION_CHUNK = 4096;  // Positions prises d'un coup par un thread
+
+    constexpr char PIECE_LETTERS[] = "PNBRQK";
+    constexpr PieceType PROMOTION_TYPES[] = { PieceType::Queen, PieceType::Rook, PieceType::Bishop, PieceType::Knight };
+    constexpr int MAX_SIDE_PIECES = 2;  // Hors roi
+
+    // Roi blanc sans pions: triangle a1-d1-d4 (a1 b1 c1 d1 b2 c2 d2 c3 d3 d4)
+    constexpr int PAWNLESS_KING_SLOTS = 10;
+    constexpr int PAWN_KING_SLOTS = 32;
+    constexpr int PAWNLESS_KING_SQUARES[PAWNLESS_KING_SLOTS] = { 0, 1, 2, 3, 9, 10, 11, 18, 19, 27 };
+    constexpr int PAWN_SQUARES = 48;  // Rangées 2 à 7
+
+    constexpr std::array<int8_t, SQUARE_COUNT> makePawnlessSlots() {
+        std::array<int8_t, SQUARE_COUNT> slots{};
+        for (int8_t& slot : slots) slot = -1;
+        for (int i = 0; i < PAWNLESS_KING_SLOTS; i++) slots[PAWNLESS_KING_SQUARES[i]] = static_cast<int8_t>(i);
+        return slots;
+    }
+    constexpr std::array<int8_t, SQUARE_COUNT> PAWNLESS_KING_SLOT = makePawnlessSlots();
+
+    // Symétrie par la grande diagonale a1-h8
+    constexpr int transposed(int square) {
+        return ((square & 7) << 3) | (square >> 3);
+    }
+
+    Bitboard attacksFrom(Piece piece, int square, Bitboard occupied) {
+        switch (typeOf(piece)) {
+            case PieceType::Pawn: return Bitboards::pawnAttacks(colorOf(piece), square);
+            case PieceType::Knight: return Bitboards::knightAttacks(square);
+            case PieceType::Bishop: return Bitboards::bishopAttacks(square, occupied);
+            case PieceType::Rook: return Bitboards::rookAttacks(square, occupied);
+            case PieceType::Queen: return Bitboards::queenAttacks(square, occupied);
+            case PieceType::King: return Bitboards::kingAttacks(square);
+            default: return 0;
+        }
+    }
+
+    /**
+     * Matériel d'une table: types hors roi de chaque camp, par valeur décroissante.
+     * Canonique si le camp blanc est le plus fort (plus de pièces, puis pièces plus fortes).
+     */
+    struct Material {
+        int types[COLOR_COUNT][MAX_SIDE_PIECES] = {};
+        int counts[COLOR_COUNT] = {};
+
+        void add(Color color, PieceType type) {
+            int side = toIndex(color);
+            types[side][counts[side]++] = toIndex(type);
+            std::sort(types[side], types[side] + counts[side], std::greater<int>());
+        }
+
+        bool blackStronger() const {
+            if (counts[0] != counts[1]) return counts[1] > counts[0];
+            for (int i = 0; i < counts[0]; i++) {
+                if (types[0][i] != types[1][i]) return types[1][i] > types[0][i];
+            }
+            return false;
+        }
+
+        void swapSides() {
+            std::swap(types[0], types[1]);
+            std::swap(counts[0], counts[1]);
+        }
+
+        // Rois seuls, ou roi et une pièce mineure: nulle sans table
+        bool triviallyDrawn() const {
+            int total = counts[0] + counts[1];
+            if (total == 0) return true;
+            if (total > 1) return false;
+            int type = counts[0] ? types[0][0] : types[1][0];
+            return type == toIndex(PieceType::Knight) || type == toIndex(PieceType::Bishop);
+        }
+
+        bool hasPawns() const {
+            for (int side = 0; side < COLOR_COUNT; side++) {
+                for (int i = 0; i < counts[side]; i++) {
+                    if (types[side][i] == toIndex(PieceType::Pawn)) return true;
+                }
+            }
+            return false;
+        }
+
+        int code() const {
+            int code = 0;
+            for (int side = 0; side < COLOR_COUNT; side++) {
+                for (int i = 0; i < MAX_SIDE_PIECES; i++) code = code * 6 + (i < counts[side] ? types[side][i] + 1 : 0);
+            }
+            return code;
+        }
+
+        std::string name() const {
+            std::string name;
+            for (int side = 0; side < COLOR_COUNT; side++) {
+                name += 'K';
+                for (int i = 0; i < counts[side]; i++) name += PIECE_LETTERS[types[side][i]];
+            }
+            return name;
+        }
+    };
+
+    bool parseMaterial(const std::string& text, Material& material) {
+        int side = -1;
+        for (char letter : text) {
+            char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(letter)));
+            if (upper == 'K') {
+                if (++side >= COLOR_COUNT) return false;
+                continue;
+            }
+            const char* found = upper ? std::strchr(PIECE_LETTERS, upper) : nullptr;
+            if (side < 0 || !found) return false;
+            if (material.counts[side] >= MAX_SIDE_PIECES) return false;
+            material.add(side == 0 ? Color::White : Color::Black, static_cast<PieceType>(found - PIECE_LETTERS));
+        }
+        if (side != 1 || material.counts[0] + material.counts[1] > EndgameBitbases::MAX_PIECES - 2) return false;
+        if (material.blackStronger()) material.swapSides();
+        return true;
+    }
+
+    uint32_t checksum(const std::vector<uint8_t>& data) {
+        uint32_t hash = 2166136261u;  // FNV-1a
+        for (uint8_t byte : data) hash = (hash ^ byte) * 16777619u;
+        return hash;
+    }
+
+    // PackBits: en-tête n < 128 → n + 1 octets copiés; n > 128 → octet suivant répété 257 - n fois
+    std::vector<uint8_t> packBits(const std::vector<uint8_t>& input) {
+        std::vector<uint8_t> output;
+        size_t size = input.size();
+        size_t i = 0;
+        while (i < size) {
+            size_t run = 1;
+            while (i + run < size && run < 128 && input[i + run] == input[i]) run++;
+            if (run >= 2) {
+                output.push_back(static_cast<uint8_t>(257 - run));
+                output.push_back(input[i]);
+                i += run;
+                continue;
+            }
+
+            // Octets isolés jusqu'au prochain doublon
+            size_t start = i;
+            while (i < size && i - start < 128 && !(i + 1 < size && input[i + 1] == input[i])) i++;
+            output.push_back(static_cast<uint8_t>(i - start - 1));
+            output.insert(output.end(), input.begin() + start, input.begin() + i);
+        }
+        return output;
+    }
+
+    bool unpackBits(const std::vector<uint8_t>& input, std::vector<uint8_t>& output) {
+        size_t written = 0;
+        size_t i = 0;
+        while (i < input.size()) {
+            uint8_t header = input[i++];
+            if (header < 128) {
+                size_t length = header + 1u;
+                if (i + length > input.size() || written + length > output.size()) return false;
+                std::copy(input.begin() + i, input.begin() + i + length, output.begin() + written);
+                i += length;
+                written += length;
+            } else if (header > 128) {
+                size_t length = 257u - header;
+                if (i >= input.size() || written + length > output.size()) return false;
+                std::fill(output.begin() + written, output.begin() + written + length, input[i++]);
+                written += length;
+            }
+        }
+        return written == output.size();
+    }
+
+    void writeLittleEndian(std::ofstream& file, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) file.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+
+    uint64_t readLittleEndian(std::ifstream& file, int bytes) {
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) value |= static_cast<uint64_t>(static_cast<uint8_t>(file.get())) << (8 * i);
+        return value;
+    }
+
+    // Répartit [0, size) entre threadCount threads par paquets; somme des retours de work(début, fin)
+    template <typename Work>
+    uint64_t parallelFor(uint64_t size, int threadCount, Work work) {
+        std::atomic<uint64_t> next{ 0 };
+        std::atomic<uint64_t> total{ 0 };
+        auto worker = [&]() {
+            while (true) {
+                uint64_t begin = next.fetch_add(GENERATION_CHUNK);
+                if (begin >= size) break;
+                total += work(begin, std::min(begin + GENERATION_CHUNK, size));
+            }
+        };
+
+        std::vector<std::thread> helpers;
+        for (int i = 1; i < threadCount; i++) helpers.emplace_back(worker);
+        worker();
+        for (std::thread& helper : helpers) helper.join();
+        return total;
+    }
+}
+
+/**
+ * Position réduite: pièces et cases dans un ordre quelconque, au plus MAX_PIECES
+ */
+struct EndgameBitbases::Setup {
+    Piece pieces[MAX_PIECES];
+    int squares[MAX_PIECES];
+    int count = 0;
+    Color sideToMove = Color::White;
+
+    Bitboard occupied() const {
+        Bitboard occupied = 0;
+        for (int i = 0; i < count; i++) occupied |= squareBB(squares[i]);
+        return occupied;
+    }
+
+    int kingSquare(Color color) const {
+        for (int i = 0; i < count; i++) {
+            if (pieces[i] == makePiece(color, PieceType::King)) return squares[i];
+        }
+        return NO_SQUARE;
+    }
+
+    bool attacked(int square, Color by) const {
+        Bitboard occupied = this->occupied();
+        for (int i = 0; i < count; i++) {
+            if (colorOf(pieces[i]) == by && (attacksFrom(pieces[i], squares[i], occupied) & squareBB(square))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Appelle visit(parent) pour chaque position d'où l'adversaire a pu arriver ici
+     * par un coup sans prise ni promotion (les autres viennent d'une autre table).
+     * Les parents ne sont pas tous légaux.
+     */
+    template <typename Visit>
+    void forEachParent(Visit visit) const {
+        Color mover = opposite(sideToMove);
+        Bitboard all = occupied();
+        for (int i = 0; i < count; i++) {
+            if (colorOf(pieces[i]) != mover) continue;
+            int to = squares[i];
+
+            // Pièces autres que les pions: mouvements réversibles, vers une case vide
+            Bitboard origins = 0;
+            if (typeOf(pieces[i]) != PieceType::Pawn) {
+                origins = attacksFrom(pieces[i], to, all) & ~all;
+            } else {
+                int back = mover == Color::White ? -8 : 8;
+                int from = to + back;
+                int firstRank = mover == Color::White ? 0 : 7;
+                int doublePushRank = mover == Color::White ? 3 : 4;
+                if (rankOf(from) != firstRank && !(all & squareBB(from))) {
+                    origins |= squareBB(from);
+                    if (rankOf(to) == doublePushRank && !(all & squareBB(from + back))) origins |= squareBB(from + back);
+                }
+            }
+
+            Setup parent = *this;
+            parent.sideToMove = mover;
+            while (origins) {
+                parent.squares[i] = popLsb(origins);
+                visit(parent);
+            }
+        }
+    }
+
+    /**
+     * Appelle visit(fils) pour chaque coup légal (sans roque ni prise en passant);
+     * s'arrête dès que visit rend true.
+     */
+    template <typename Visit>
+    void forEachChild(Visit visit) const {
+        Color us = sideToMove;
+        Color them = opposite(us);
+        Bitboard all = occupied();
+        Bitboard ours = 0;
+        for (int i = 0; i < count; i++) {
+            if (colorOf(pieces[i]) == us) ours |= squareBB(squares[i]);
+        }
+
+        auto play = [&](int mover, int to, PieceType promotion) {
+            Setup child;
+            child.sideToMove = them;
+            for (int i = 0; i < count; i++) {
+                if (i != mover && squares[i] == to) continue;  // Pièce prise
+                child.pieces[child.count] = i == mover && promotion != PieceType::None
+                                          ? makePiece(us, promotion) : pieces[i];
+                child.squares[child.count++] = i == mover ? to : squares[i];
+            }
+            if (child.attacked(child.kingSquare(us), them)) return false;
+            return visit(child);
+        };
+
+        for (int i = 0; i < count; i++) {
+            if (colorOf(pieces[i]) != us) continue;
+            int from = squares[i];
+
+            if (typeOf(pieces[i]) != PieceType::Pawn) {
+                Bitboard targets = attacksFrom(pieces[i], from, all) & ~ours;
+                while (targets) {
+                    if (play(i, popLsb(targets), PieceType::None)) return;
+                }
+                continue;
+            }
+
+            int forward = us == Color::White ? 8 : -8;
+            int lastRank = us == Color::White ? 7 : 0;
+            Bitboard targets = Bitboards::pawnAttacks(us, from) & all & ~ours;
+            if (!(all & squareBB(from + forward))) {
+                targets |= squareBB(from + forward);
+                int startRank = us == Color::White ? 1 : 6;
+                if (rankOf(from) == startRank && !(all & squareBB(from + 2 * forward))) {
+                    targets |= squareBB(from + 2 * forward);
+                }
+            }
+            while (targets) {
+                int to = popLsb(targets);
+                if (rankOf(to) != lastRank) {
+                    if (play(i, to, PieceType::None)) return;
+                    continue;
+                }
+                for (PieceType promotion : PROMOTION_TYPES) {
+                    if (play(i, to, promotion)) return;
+                }
+            }
+        }
+    }
+};
+
+struct EndgameBitbases::Table {
+    std::string material;
+    Piece pieces[MAX_PIECES];  // Ordre de l'index: roi blanc, roi noir, pièces blanches puis noires
+    int count = 0;
+    bool pawns = false;
+    int kingSlots = 0;
+    uint64_t size = 0;         // Positions, deux traits
+
+    std::vector<uint8_t> packed;                    // Deux bits par position
+    std::unique_ptr<std::atomic<uint8_t>[]> work;   // Pendant la génération seulement
+    std::string path;                               // Fichier chargé au premier accès
+    std::once_flag loadOnce;
+    std::atomic<bool> ready{ false };
+
+    explicit Table(const Material& canonical) {
+        material = canonical.name();
+        pieces[0] = makePiece(Color::White, PieceType::King);
+        pieces[1] = makePiece(Color::Black, PieceType::King);
+        count = 2;
+        for (int side = 0; side < COLOR_COUNT; side++) {
+            for (int i = 0; i < canonical.counts[side]; i++) {
+                pieces[count++] = makePiece(side == 0 ? Color::White : Color::Black,
+                                            static_cast<PieceType>(canonical.types[side][i]));
+            }
+        }
+        pawns = canonical.hasPawns();
+        kingSlots = pawns ? PAWN_KING_SLOTS : PAWNLESS_KING_SLOTS;
+        size = static_cast<uint64_t>(COLOR_COUNT) * kingSlots * SQUARE_COUNT;
+        for (int i = 2; i < count; i++) size *= typeOf(pieces[i]) == PieceType::Pawn ? PAWN_SQUARES : SQUARE_COUNT;
+    }
+
+    // squares dans l'ordre de pieces
+    uint64_t index(Color sideToMove, const int* squares) const {
+        // Roi blanc sur les colonnes a-d, et sans pions sous la diagonale de la moitié basse
+        int flip = fileOf(squares[0]) > 3 ? 7 : 0;
+        if (!pawns && rankOf(squares[0]) > 3) flip ^= 56;
+        int king = squares[0] ^ flip;
+        bool transpose = !pawns && rankOf(king) > fileOf(king);
+        auto map = [&](int square) { return transpose ? transposed(square ^ flip) : square ^ flip; };
+
+        king = map(squares[0]);
+        uint64_t index = sideToMove == Color::White ? 0 : 1;
+        index = index * kingSlots + (pawns ? rankOf(king) * 4 + fileOf(king) : PAWNLESS_KING_SLOT[king]);
+        index = index * SQUARE_COUNT + map(squares[1]);
+        for (int i = 2; i < count; i++) {
+            int square = map(squares[i]);
+            if (typeOf(pieces[i]) == PieceType::Pawn) index = index * PAWN_SQUARES + (square - 8);
+            else index = index * SQUARE_COUNT + square;
+        }
+        return index;
+    }
+
+    void decode(uint64_t index, Setup& setup) const {
+        setup.count = count;
+        for (int i = count - 1; i >= 2; i--) {
+            setup.pieces[i] = pieces[i];
+            if (typeOf(pieces[i]) == PieceType::Pawn) {
+                setup.squares[i] = static_cast<int>(index % PAWN_SQUARES) + 8;
+                index /= PAWN_SQUARES;
+            } else {
+                setup.squares[i] = static_cast<int>(index % SQUARE_COUNT);
+                index /= SQUARE_COUNT;
+            }
+        }
+        setup.pieces[1] = pieces[1];
+        setup.squares[1] = static_cast<int>(index % SQUARE_COUNT);
+        index /= SQUARE_COUNT;
+        int slot = static_cast<int>(index % kingSlots);
+        setup.pieces[0] = pieces[0];
+        setup.squares[0] = pawns ? (slot / 4) * 8 + slot % 4 : PAWNLESS_KING_SQUARES[slot];
+        setup.sideToMove = index / kingSlots == 0 ? Color::White : Color::Black;
+    }
+
+    uint8_t value(uint64_t index) const {
+        if (work) return work[index].load(std::memory_order_relaxed);
+        return (packed[index >> 2] >> ((index & 3) * 2)) & 3;
+    }
+};
+
+EndgameBitbases::EndgameBitbases() = default;
+EndgameBitbases::~EndgameBitbases() = default;
+
+std::string EndgameBitbases::normalize(const std::string& material) {
+    Material parsed;
+    return parseMaterial(material, parsed) ? parsed.name() : std::string();
+}
+
+std::vector<std::string> EndgameBitbases::allMaterials(int maxPieces) {
+    // Camp fort avec une ou deux pièces, camp faible avec au plus autant
+    std::vector<std::string> materials;
+    const char strong[] = "QRBNP";
+    for (int pieces = 3; pieces <= std::min(maxPieces, MAX_PIECES); pieces++) {
+        for (int a = 0; a < 5; a++) {
+            if (pieces == 3) {
+                materials.push_back(std::string("K") + strong[a] + "K");
+                continue;
+            }
+            for (int b = a; b < 5; b++) {
+                materials.push_back(std::string("K") + strong[a] + strong[b] + "K");
+                materials.push_back(std::string("K") + strong[a] + "K" + strong[b]);
+            }
+        }
+    }
+
+    std::vector<std::string> result;
+    for (const std::string& material : materials) {
+        Material parsed;
+        parseMaterial(material, parsed);
+        if (!parsed.triviallyDrawn()) result.push_back(parsed.name());
+    }
+    return result;
+}
+
+EndgameBitbases::Table* EndgameBitbases::tableFor(const std::string& material) const {
+    Material parsed;
+    if (!parseMaterial(material, parsed)) return nullptr;
+    return m_tables[parsed.code()].get();
+}
+
+bool EndgameBitbases::isReady(Table& table) const {
+    if (table.work) return true;
+    std::call_once(table.loadOnce, [&]() { load(table); });
+    return table.ready.load(std::memory_order_acquire);
+}
+
+bool EndgameBitbases::contains(const std::string& material) const {
+    Table* table = tableFor(material);
+    return table && isReady(*table);
+}
+
+std::vector<std::string> EndgameBitbases::materials() const {
+    std::vector<std::string> materials;
+    for (const auto& table : m_tables) {
+        if (table && (table->ready || !table->path.empty())) materials.push_back(table->material);
+    }
+    return materials;
+}
+
+uint8_t EndgameBitbases::lookup(const Setup& setup) const {
+    // Tri des pièces par camp et par valeur, comme dans l'index de la table
+    Material material;
+    int kings[COLOR_COUNT] = { NO_SQUARE, NO_SQUARE };
+    int squares[COLOR_COUNT][MAX_SIDE_PIECES];
+    for (int i = 0; i < setup.count; i++) {
+        // Case vide dans la liste: aucune table ne correspond (et side reste un index valide)
+        Color color = colorOf(setup.pieces[i]);
+        if (color == Color::None) return NO_TABLE;
+        int side = toIndex(color);
+        if (typeOf(setup.pieces[i]) == PieceType::King) {
+            kings[side] = setup.squares[i];
+            continue;
+        }
+        if (material.counts[side] >= MAX_SIDE_PIECES) return NO_TABLE;
+        int slot = material.counts[side];
+        material.types[side][slot] = toIndex(typeOf(setup.pieces[i]));
+        squares[side][slot] = setup.squares[i];
+        material.counts[side]++;
+        if (slot == 1 && material.types[side][1] > material.types[side][0]) {
+            std::swap(material.types[side][0], material.types[side][1]);
+            std::swap(squares[side][0], squares[side][1]);
+        }
+    }
+    if (kings[0] == NO_SQUARE || kings[1] == NO_SQUARE) return NO_TABLE;
+    if (material.triviallyDrawn()) return DRAW;
+
+    // Camp fort en blanc: couleurs échangées et plateau retourné
+    Color sideToMove = setup.sideToMove;
+    int flip = 0;
+    if (material.blackStronger()) {
+        material.swapSides();
+        std::swap(kings[0], kings[1]);
+        std::swap(squares[0], squares[1]);
+        sideToMove = opposite(sideToMove);
+        flip = 56;
+    }
+
+    Table* table = m_tables[material.code()].get();
+    if (!table || !isReady(*table)) return NO_TABLE;
+
+    int ordered[MAX_PIECES] = { kings[0] ^ flip, kings[1] ^ flip };
+    int count = 2;
+    for (int side = 0; side < COLOR_COUNT; side++) {
+        for (int i = 0; i < material.counts[side]; i++) ordered[count++] = squares[side][i] ^ flip;
+    }
+    return table->value(table->index(sideToMove, ordered));
+}
+
+bool EndgameBitbases::probe(const Position& position, Wdl& result) const {
+    if (popCount(position.pieces()) > MAX_PIECES || position.castlingRights()) return false;
+
+    // Les tables ignorent la prise en passant: position refusée seulement si elle est jouable
+    Color us = position.sideToMove();
+    int epSquare = position.enPassantSquare();
+    if (epSquare != NO_SQUARE
+        && (Bitboards::pawnAttacks(opposite(us), epSquare) & position.pieces(us, PieceType::Pawn))) {
+        return false;
+    }
+
+    Setup setup;
+    setup.sideToMove = us;
+    Bitboard occupied = position.pieces();
+    while (occupied) {
+        int square = popLsb(occupied);
+        setup.pieces[setup.count] = position.pieceOn(square);
+        setup.squares[setup.count++] = square;
+    }
+
+    switch (lookup(setup)) {
+        case WIN: result = Wdl::Win; return true;
+        case LOSS: result = Wdl::Loss; return true;
+        case DRAW: result = Wdl::Draw; return true;
+        default: return false;
+    }
+}
+
+uint8_t EndgameBitbases::childValue(const Table& table, const Setup& parent, const Setup& child) const {
+    // Coup calme: même table, pièces dans le même ordre; sinon table de la prise ou de la promotion
+    bool sameTable = child.count == parent.count && std::equal(child.pieces, child.pieces + child.count, parent.pieces);
+    return sameTable ? table.value(table.index(child.sideToMove, child.squares)) : lookup(child);
+}
+
+uint8_t EndgameBitbases::resolve(const Table& table, const Setup& setup) const {
+    // Gagnée dès qu'un fils est perdu pour l'adversaire; perdue si tous sont gagnés pour lui
+    bool anyMove = false;
+    bool allWon = true;
+    bool won = false;
+    setup.forEachChild([&](const Setup& child) {
+        anyMove = true;
+        uint8_t value = childValue(table, setup, child);
+        if (value == LOSS) return won = true;
+        if (value != WIN) allWon = false;
+        return false;
+    });
+
+    if (won) return WIN;
+    if (!anyMove) return setup.attacked(setup.kingSquare(setup.sideToMove), opposite(setup.sideToMove)) ? LOSS : DRAW;
+    return allWon ? LOSS : UNKNOWN;
+}
+
+void EndgameBitbases::build(Table& table, int threadCount) {
+    auto start = std::chrono::steady_clock::now();
+    table.work = std::make_unique<std::atomic<uint8_t>[]>(table.size);
+    std::atomic<uint8_t>* work = table.work.get();
+
+    // Première passe: positions illégales (cases partagées, roi adverse en prise), mats, pats,
+    // et positions décidées par une prise ou une promotion
+    parallelFor(table.size, threadCount, [&](uint64_t begin, uint64_t end) {
+        Setup setup;
+        for (uint64_t index = begin; index < end; index++) {
+            table.decode(index, setup);
+            bool legal = popCount(setup.occupied()) == setup.count
+                      && !setup.attacked(setup.kingSquare(opposite(setup.sideToMove)), setup.sideToMove);
+            work[index].store(legal ? resolve(table, setup) : ILLEGAL, std::memory_order_relaxed);
+        }
+        return uint64_t(0);
+    });
+
+    // Propagation vers les parents (coups déjoués). Parent d'une position perdue: gagné.
+    // Parent d'une position gagnée: perdu si tous ses fils le sont, vérifié à la passe pending[index].
+    auto pending = std::make_unique<std::atomic<uint16_t>[]>(table.size);
+    auto forEachParentIndex = [&](const Setup& setup, auto visit) {
+        setup.forEachParent([&](const Setup& parent) {
+            visit(parent, table.index(parent.sideToMove, parent.squares));
+            // Roi blanc sur la diagonale: la position et sa symétrique ont chacune leur index
+            if (!table.pawns) {
+                int mirrored[MAX_PIECES];
+                for (int i = 0; i < parent.count; i++) mirrored[i] = transposed(parent.squares[i]);
+                visit(parent, table.index(parent.sideToMove, mirrored));
+            }
+        });
+    };
+    auto markParents = [&](const Setup& setup, uint16_t pass) {
+        forEachParentIndex(setup, [&](const Setup&, uint64_t index) {
+            pending[index].store(pass, std::memory_order_release);
+        });
+    };
+    auto propagateLoss = [&](const Setup& setup, uint16_t pass) {
+        uint64_t won = 0;
+        forEachParentIndex(setup, [&](const Setup& parent, uint64_t index) {
+            uint8_t expected = UNKNOWN;
+            if (work[index].compare_exchange_strong(expected, WIN, std::memory_order_relaxed)) {
+                markParents(parent, pass);
+                won++;
+            }
+        });
+        return won;
+    };
+
+    uint16_t pass = 2;
+    uint64_t changed = parallelFor(table.size, threadCount, [&](uint64_t begin, uint64_t end) {
+        Setup setup;
+        uint64_t resolved = 0;
+        for (uint64_t index = begin; index < end; index++) {
+            uint8_t value = work[index].load(std::memory_order_relaxed);
+            if (value != WIN && value != LOSS) continue;
+            table.decode(index, setup);
+            if (value == WIN) markParents(setup, pass + 1);
+            else resolved += propagateLoss(setup, pass + 1);
+        }
+        return resolved + 1;
+    });
+
+    // Jusqu'à stabilité: les positions marquées dont tous les fils sont gagnés sont perdues
+    while (changed) {
+        pass++;
+        changed = parallelFor(table.size, threadCount, [&](uint64_t begin, uint64_t end) {
+            Setup setup;
+            uint64_t resolved = 0;
+            for (uint64_t index = begin; index < end; index++) {
+                uint16_t due = pending[index].load(std::memory_order_relaxed);
+                if (due == 0 || due > pass || work[index].load(std::memory_order_relaxed) != UNKNOWN) continue;
+                // Une marque posée pendant l'examen le relancera à la passe suivante
+                pending[index].exchange(0, std::memory_order_acquire);
+                table.decode(index, setup);
+
+                bool allWon = true;
+                setup.forEachChild([&](const Setup& child) {
+                    allWon = childValue(table, setup, child) == WIN;
+                    return !allWon;
+                });
+                uint8_t expected = UNKNOWN;
+                if (!allWon || !work[index].compare_exchange_strong(expected, LOSS, std::memory_order_relaxed)) continue;
+                resolved += 1 + propagateLoss(setup, pass + 1);
+            }
+            return resolved;
+        });
+    }
+    int passes = pass;
+
+    // Le reste est nul; une position illégale prend la valeur de la précédente (plages plus longues)
+    uint64_t counts[ILLEGAL + 1] = {};
+    table.packed.assign((table.size + 3) / 4, 0);
+    uint8_t previous = DRAW;
+    for (uint64_t index = 0; index < table.size; index++) {
+        uint8_t value = work[index].load(std::memory_order_relaxed);
+        counts[value]++;
+        if (value == UNKNOWN) value = DRAW;
+        if (value == ILLEGAL) value = previous;
+        previous = value;
+        table.packed[index >> 2] |= static_cast<uint8_t>(value << ((index & 3) * 2));
+    }
+    table.work.reset();
+    table.ready.store(true, std::memory_order_release);
+
+    uint64_t legal = table.size - counts[ILLEGAL];
+    auto percent = [&](uint64_t count) { return legal ? static_cast<int>(count * 100 / legal) : 0; };
+    int ms = static_cast<int>(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    std::cout << "[Bitbase] Generated " << table.material << ": " << legal << " positions, " << passes << " passes, "
+              << ms << " ms (win " << percent(counts[WIN]) << "%, draw " << percent(counts[DRAW] + counts[UNKNOWN])
+              << "%, loss " << percent(counts[LOSS]) << "%)" << std::endl;
+}
+
+bool EndgameBitbases::generate(const std::string& material, int threadCount) {
+    Material parsed;
+    if (!parseMaterial(material, parsed)) {
+        std::cout << "[Bitbase] Invalid material " << material << std::endl;
+        return false;
+    }
+    if (parsed.triviallyDrawn()) return true;
+    if (contains(parsed.name())) return true;
+
+    // Tables atteintes par une prise ou une promotion, générées d'abord
+    for (int side = 0; side < COLOR_COUNT; side++) {
+        for (int i = 0; i < parsed.counts[side]; i++) {
+            Material captured;
+            for (int s = 0; s < COLOR_COUNT; s++) {
+                for (int j = 0; j < parsed.counts[s]; j++) {
+                    if (s != side || j != i) captured.add(s == 0 ? Color::White : Color::Black, static_cast<PieceType>(parsed.types[s][j]));
+                }
+            }
+            if (!generate(captured.name(), threadCount)) return false;
+
+            if (parsed.types[side][i] != toIndex(PieceType::Pawn)) continue;
+            for (PieceType promotion : PROMOTION_TYPES) {
+                Material promoted = captured;
+                promoted.add(side == 0 ? Color::White : Color::Black, promotion);
+                if (!generate(promoted.name(), threadCount)) return false;
+            }
+        }
+    }
+
+    if (threadCount <= 0) threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    auto& slot = m_tables[parsed.code()];
+    slot = std::make_unique<Table>(parsed);
+    std::call_once(slot->loadOnce, []() {});  // Table générée: rien à charger
+    build(*slot, threadCount);
+    return true;
+}
+
+bool EndgameBitbases::save(const std::string& material, const std::string& directory) const {
+    Table* table = tableFor(material);
+    if (!table || !isReady(*table)) {
+        std::cout << "[Bitbase] No table " << material << " to save" << std::endl;
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    std::string path = (std::filesystem::path(directory) / (table->material + FILE_EXTENSION)).string();
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cout << "[Bitbase] Cannot write " << path << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> compressed = packBits(table->packed);
+    char name[MATERIAL_NAME_SIZE] = {};
+    table->material.copy(name, MATERIAL_NAME_SIZE);
+    file.write(MAGIC, sizeof(MAGIC));
+    writeLittleEndian(file, VERSION, 4);
+    file.write(name, MATERIAL_NAME_SIZE);
+    writeLittleEndian(file, table->size, 8);
+    writeLittleEndian(file, compressed.size(), 8);
+    writeLittleEndian(file, checksum(table->packed), 4);
+    file.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+    if (!file) return false;
+
+    std::cout << "[Bitbase] Saved " << path << " (" << compressed.size() << " bytes, "
+              << table->packed.size() << " unpacked)" << std::endl;
+    return true;
+}
+
+int EndgameBitbases::open(const std::string& directory) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        std::cout << "[Bitbase] No bitbase directory " << directory << std::endl;
+        return 0;
+    }
+
+    // Seuls les en-têtes sont lus ici; les données le seront au premier accès
+    int found = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (entry.path().extension() != FILE_EXTENSION) continue;
+        std::ifstream file(entry.path(), std::ios::binary);
+        char magic[sizeof(MAGIC)] = {};
+        char name[MATERIAL_NAME_SIZE + 1] = {};
+        file.read(magic, sizeof(magic));
+        uint32_t version = static_cast<uint32_t>(readLittleEndian(file, 4));
+        file.read(name, MATERIAL_NAME_SIZE);
+        uint64_t size = readLittleEndian(file, 8);
+
+        Material parsed;
+        if (!file || !std::equal(magic, magic + sizeof(MAGIC), MAGIC) || version != VERSION
+            || !parseMaterial(name, parsed) || parsed.name() != name || parsed.triviallyDrawn()) {
+            std::cout << "[Bitbase] Ignoring invalid file " << entry.path().string() << std::endl;
+            continue;
+        }
+        auto table = std::make_unique<Table>(parsed);
+        if (table->size != size) {
+            std::cout << "[Bitbase] Ignoring " << entry.path().string() << ": unexpected size" << std::endl;
+            continue;
+        }
+        table->path = entry.path().string();
+        m_tables[parsed.code()] = std::move(table);
+        found++;
+    }
+
+    std::cout << "[Bitbase] Found " << found << " tables in " << directory << std::endl;
+    return found;
+}
+
+bool EndgameBitbases::load(Table& table) const {
+    if (table.path.empty()) return false;
+
+    std::ifstream file(table.path, std::ios::binary);
+    file.seekg(sizeof(MAGIC) + 4 + MATERIAL_NAME_SIZE + 8);
+    uint64_t compressedSize = readLittleEndian(file, 8);
+    uint32_t expected = static_cast<uint32_t>(readLittleEndian(file, 4));
+    std::vector<uint8_t> compressed(static_cast<size_t>(compressedSize));
+    file.read(reinterpret_cast<char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+
+    std::vector<uint8_t> packed(static_cast<size_t>((table.size + 3) / 4));
+    if (!file || !unpackBits(compressed, packed) || checksum(packed) != expected) {
+        std::cout << "[Bitbase] Corrupted file " << table.path << std::endl;
+        return false;
+    }
+    table.packed = std::move(packed);
+    table.ready.store(true, std::memory_order_release);
+    std::cout << "[Bitbase] Loaded " << table.material << " (" << table.packed.size() / 1024 << " KB)" << std::endl;
+    return true;
+}
+
+std::shared_ptr<const EndgameBitbases> EndgameBitbases::openShared(const std::string& directory) {
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<const EndgameBitbases>> opened;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (auto existing = opened[directory].lock()) return existing;
+
+    auto bitbases = std::make_shared<EndgameBitbases>();
+    bitbases->open(directory);
+    for (const char* material : { "KPK", "KRK", "KQK" }) bitbases->generate(material);
+    opened[directory] = bitbases;
+    return bitbases;
+}
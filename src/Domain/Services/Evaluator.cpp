@@ -1,51 +1,151 @@
 #include "Evaluator.h"
-#include "ChessBoard.h"
-#include "Entities/ChessPiece.h"
-#include "Rules/MoveValidator.h"
-#include <cmath>
-
-double Evaluator::evaluatePosition(const ChessBoard& board, const std::string& playerColor) {
-    // Calcul silencieux du score total basé sur plusieurs facteurs
-    double materialScore = getMaterialValue(board, playerColor) - getMaterialValue(board, (playerColor == "white") ? "black" : "white");
-    double mobilityScore = getMobilityScore(board, playerColor) - getMobilityScore(board, (playerColor == "white") ? "black" : "white");
-    double kingSafetyScore = getKingSafetyScore(board, playerColor) - getKingSafetyScore(board, (playerColor == "white") ? "black" : "white");
-    
-    // Pondération des différents facteurs (calcul silencieux)
-    return materialScore * 1.0 +           // Le matériel est le plus important
-           mobilityScore * 0.1 +            // La mobilité est secondaire
+#include "Entities/Position.h"
+#include "PawnHashTable.h"
+#include <algorithm>
+
+namespace {
+    // Valeurs standard des pièces, indexées par PieceType (None = 0)
+    constexpr double PIECE_VALUES[PIECE_TYPE_COUNT + 1] = {
+        1.0,     // Pawn
+        3.0,     // Knight
+        3.0,     // Bishop
+        5.0,     // Rook
+        9.0,     // Queen
+        1000.0,  // King: valeur très élevée
+        0.0      // None
+    };
+
+    // Mobilité: bonus (mg, eg) par case atteinte au-delà d'une mobilité moyenne
+    constexpr PieceSquare::Score MOBILITY_WEIGHTS[PIECE_TYPE_COUNT] = {
+        { 0, 0 }, { 4, 4 }, { 5, 5 }, { 2, 4 }, { 1, 2 }, { 0, 0 }
+    };
+    constexpr int MOBILITY_BASE[PIECE_TYPE_COUNT] = { 0, 4, 6, 7, 13, 0 };
+
+    // Cases attaquées par un ensemble de pions, par décalage de tout le bitboard
+    Bitboard pawnAttacks(Bitboard pawns, Color color) {
+        return color == Color::White ? ((pawns << 9) & ~FILE_A_BB) | ((pawns << 7) & ~FILE_H_BB)
+                                     : ((pawns >> 7) & ~FILE_A_BB) | ((pawns >> 9) & ~FILE_H_BB);
+    }
+
+    template <PieceType Type>
+    Bitboard attacksOf(int square, Bitboard occupied) {
+        if constexpr (Type == PieceType::Knight) return Bitboards::knightAttacks(square);
+        else if constexpr (Type == PieceType::Bishop) return Bitboards::bishopAttacks(square, occupied);
+        else if constexpr (Type == PieceType::Rook) return Bitboards::rookAttacks(square, occupied);
+        else return Bitboards::queenAttacks(square, occupied);
+    }
+
+    template <PieceType Type, typename Visitor>
+    void visitMobility(const Position& position, Color color, Bitboard area, Visitor& visit) {
+        Bitboard occupied = position.pieces();
+        Bitboard pieces = position.pieces(color, Type);
+        while (pieces) {
+            visit(Type, popCount(attacksOf<Type>(popLsb(pieces), occupied) & area));
+        }
+    }
+
+    // Cases atteintes par chaque pièce (hors pions et roi), d'après les bitboards d'attaque:
+    // cases vides ou adverses, sauf celles tenues par un pion adverse
+    template <typename Visitor>
+    void forEachMobility(const Position& position, Color color, Visitor visit) {
+        Color them = opposite(color);
+        Bitboard area = ~position.pieces(color) & ~pawnAttacks(position.pieces(them, PieceType::Pawn), them);
+
+        visitMobility<PieceType::Knight>(position, color, area, visit);
+        visitMobility<PieceType::Bishop>(position, color, area, visit);
+        visitMobility<PieceType::Rook>(position, color, area, visit);
+        visitMobility<PieceType::Queen>(position, color, area, visit);
+    }
+
+    // Pion passé dont la case d'avance est libre (finale surtout), selon sa rangée relative
+    constexpr PieceSquare::Score FREE_PASSER_BONUS = { 2, 6 };
+
+    PieceSquare::Score passedPawns(const Position& position, Color color, Bitboard passed) {
+        PieceSquare::Score score;
+        while (passed) {
+            int square = popLsb(passed);
+            int stop = color == Color::White ? square + 8 : square - 8;
+            if (stop < 0 || stop >= SQUARE_COUNT || !position.isEmpty(stop)) continue;
+            int rank = color == Color::White ? rankOf(square) : 7 - rankOf(square);
+            score += { FREE_PASSER_BONUS.mg * rank, FREE_PASSER_BONUS.eg * rank };
+        }
+        return score;
+    }
+
+    PieceSquare::Score mobility(const Position& position, Color color) {
+        PieceSquare::Score score;
+        forEachMobility(position, color, [&score](PieceType type, int count) {
+            const PieceSquare::Score& weight = MOBILITY_WEIGHTS[toIndex(type)];
+            int extra = count - MOBILITY_BASE[toIndex(type)];
+            score += { weight.mg * extra, weight.eg * extra };
+        });
+        return score;
+    }
+}
+
+double Evaluator::evaluatePosition(const Position& position, Color color) {
+    // Évaluation de la recherche (centipions -> pions), plus la sécurité du roi
+    Color them = opposite(color);
+    int score = evaluateForWhite(position, nullptr);
+    double kingSafetyScore = getKingSafetyScore(position, color) - getKingSafetyScore(position, them);
+
+    return (color == Color::White ? score : -score) / 100.0 +
            kingSafetyScore * 0.5;           // La sécurité du roi est importante
 }
 
-double Evaluator::getMaterialValue(const ChessBoard& board, const std::string& playerColor) {
+int Evaluator::evaluate(const Position& position, PawnHashTable* pawnTable) {
+    int score = evaluateForWhite(position, pawnTable);
+    return position.sideToMove() == Color::White ? score : -score;
+}
+
+int Evaluator::evaluateForWhite(const Position& position, PawnHashTable* pawnTable) {
+    // Matériel et tables pièce-case sont tenus à jour par Position: seule la mobilité est calculée
+    PieceSquare::Score score = position.psqScore();
+    score += mobility(position, Color::White);
+    score -= mobility(position, Color::Black);
+
+    // Structure de pions: lue dans la table quand elle a déjà été vue
+    PawnEntry localEntry;
+    PawnEntry* pawns = &localEntry;
+    if (pawnTable) {
+        pawns = &pawnTable->probe(position);
+    } else {
+        PawnHashTable::evaluate(position, localEntry);
+    }
+    for (Color color : { Color::White, Color::Black }) {
+        PieceSquare::Score pawnScore = pawns->scores[toIndex(color)];
+        pawnScore += pawns->shield(position, color);
+        pawnScore += passedPawns(position, color, pawns->passedPawns[toIndex(color)]);
+        if (color == Color::White) score += pawnScore;
+        else score -= pawnScore;
+    }
+
+    // Mélange milieu de partie / finale selon le matériel restant
+    int phase = std::min(position.gamePhase(), PieceSquare::MAX_PHASE);
+    return (score.mg * phase + score.eg * (PieceSquare::MAX_PHASE - phase)) / PieceSquare::MAX_PHASE;
+}
+
+double Evaluator::getMaterialValue(const Position& position, Color color) {
     double totalValue = 0.0;
     
-    // Parcourir tout le plateau (calcul silencieux)
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            const ChessPiece* piece = board.getPieceAt(row, col);
-            if (piece && !piece->type.empty() && piece->color == playerColor) {
-                totalValue += getPieceValue(piece->type);
-            }
-        }
+    // Un popcount par type de pièce au lieu de parcourir les 64 cases
+    for (int type = 0; type < PIECE_TYPE_COUNT; ++type) {
+        totalValue += position.count(color, static_cast<PieceType>(type)) * PIECE_VALUES[type];
     }
     
     return totalValue;
 }
 
-double Evaluator::getMobilityScore(const ChessBoard& board, const std::string& playerColor) {
-    // Calcul silencieux de la mobilité (pas de logs pour éviter la verbosité)
-    MoveValidator validator(&board);
-    std::vector<Move> validMoves = validator.getAllValidMovesForColor(playerColor);
-    
-    // Score basé sur le nombre de coups possibles
-    return static_cast<double>(validMoves.size());
+double Evaluator::getMobilityScore(const Position& position, Color color) {
+    // Cases atteintes par les pièces, sans générer de coups
+    int total = 0;
+    forEachMobility(position, color, [&total](PieceType, int count) { total += count; });
+    return static_cast<double>(total);
 }
 
-double Evaluator::getKingSafetyScore(const ChessBoard& board, const std::string& playerColor) {
-    MoveValidator validator(&board);
-    
+double Evaluator::getKingSafetyScore(const Position& position, Color color) {
     // Pénalité si le roi est en échec (calcul silencieux)
-    if (validator.isInCheck(playerColor)) {
+    if (position.isInCheck(color)) {
         return -50.0;  // Pénalité importante pour être en échec
     }
     
@@ -53,14 +153,6 @@ double Evaluator::getKingSafetyScore(const ChessBoard& board, const std::string&
     return 0.0;
 }
 
-double Evaluator::getPieceValue(const std::string& pieceType) {
-    // Valeurs standard des pièces d'échecs (calcul silencieux)
-    if (pieceType == "pawn") return 1.0;
-    if (pieceType == "knight") return 3.0;
-    if (pieceType == "bishop") return 3.0;
-    if (pieceType == "rook") return 5.0;
-    if (pieceType == "queen") return 9.0;
-    if (pieceType == "king") return 1000.0;  // Valeur très élevée pour le roi
-    
-    return 0.0;  // Pièce inconnue
-}
\ No newline at end of file
+double Evaluator::getPieceValue(PieceType pieceType) {
+    return PIECE_VALUES[toIndex(pieceType)];
+}
@@ -6,9 +6,11 @@
 #include "Services/ChessClock.h"  // Add chess clock include
 #include "AIEngine.h"
 #include "BoardTheme.h"
+#include "EndgameBitbases.h"
+#include "Search.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
-#include <cstdlib>  // Pour rand()
-#include <ctime>    // Pour initialiser le générateur aléatoire
 
 GameController::GameController()
     : boardInitialized(false), whiteTurn(true), gamePaused(false),
@@ -19,19 +21,20 @@ GameController::GameController()
       currentGameResult(GameResult::ONGOING),
       currentEndReason(GameEndReason::NONE),
       aiEnabled(false), aiColor("black"), aiThinking(false), aiThinkingTimer(0.0f),
+      ponderEnabled(true), aiPondering(false),
+      analysisLines(3), analysisKey(0),
       currentGameState(GameState::PLAYING),
       pendingPromotionRow(-1), pendingPromotionCol(-1), pendingPromotionColor(""),
       whiteWasInCheck(false), blackWasInCheck(false) {
     
-    // Initialiser le générateur aléatoire pour les délais IA
-    srand(static_cast<unsigned int>(time(nullptr)));
-    
     // Initialize sound system
     std::string assetsPath = "C:/Users/abdel/OneDrive - uit.ac.ma/Bureau/M1-IAOC/Conception and Programing CPP/ChessMasterUIT-Project/ChessMasterUIT/assets/";
     soundManager.loadSounds(assetsPath);
 }
 
 GameController::~GameController() {
+    stopAnalysis();
+    cancelAIThinking();
     delete scoreSystem;
 }
 
@@ -48,15 +51,14 @@ void GameController::initializeBoard(float x, float y, float size) {
     clearLegalMoves();
     gamePaused = false;
     gameEnded = false;
-    aiThinking = false;
-    aiThinkingTimer = 0.0f;
+    cancelAIThinking();
     moveCount = 0;
     currentGameResult = GameResult::ONGOING;
     currentEndReason = GameEndReason::NONE;
     
     // Initialiser MoveValidator et GameEndEvaluator
-    moveValidator = std::make_unique<MoveValidator>(&chessBoard);
-    gameEndEvaluator = std::make_unique<GameEndEvaluator>(&chessBoard, moveValidator.get());
+    moveValidator = std::make_unique<MoveValidator>(&chessBoard.getPosition());
+    gameEndEvaluator = std::make_unique<GameEndEvaluator>(&chessBoard.getGameRecord(), moveValidator.get());
     
     // Initialize score
     updateGameScore();
@@ -87,15 +89,14 @@ void GameController::initializeBoard(float x, float y, float size, const ThemeCo
     clearLegalMoves();
     gamePaused = false;
     gameEnded = false;
-    aiThinking = false;
-    aiThinkingTimer = 0.0f;
+    cancelAIThinking();
     moveCount = 0;
     currentGameResult = GameResult::ONGOING;
     currentEndReason = GameEndReason::NONE;
     
     // Initialiser MoveValidator et GameEndEvaluator
-    moveValidator = std::make_unique<MoveValidator>(&chessBoard);
-    gameEndEvaluator = std::make_unique<GameEndEvaluator>(&chessBoard, moveValidator.get());
+    moveValidator = std::make_unique<MoveValidator>(&chessBoard.getPosition());
+    gameEndEvaluator = std::make_unique<GameEndEvaluator>(&chessBoard.getGameRecord(), moveValidator.get());
     
     // Initialize score
     updateGameScore();
@@ -128,15 +129,14 @@ void GameController::initializeBoard(float x, float y, float size, const ThemeCo
     clearLegalMoves();
     gamePaused = false;
     gameEnded = false;
-    aiThinking = false;
-    aiThinkingTimer = 0.0f;
+    cancelAIThinking();
     moveCount = 0;
     currentGameResult = GameResult::ONGOING;
     currentEndReason = GameEndReason::NONE;
     
     // Initialiser MoveValidator et GameEndEvaluator
-    moveValidator = std::make_unique<MoveValidator>(&chessBoard);
-    gameEndEvaluator = std::make_unique<GameEndEvaluator>(&chessBoard, moveValidator.get());
+    moveValidator = std::make_unique<MoveValidator>(&chessBoard.getPosition());
+    gameEndEvaluator = std::make_unique<GameEndEvaluator>(&chessBoard.getGameRecord(), moveValidator.get());
     
     // Initialize score
     updateGameScore();
@@ -162,8 +162,7 @@ void GameController::resetGame() {
     gameEnded = false;
     moveCount = 0;
     clearLegalMoves();
-    aiThinking = false;
-    aiThinkingTimer = 0.0f;
+    cancelAIThinking();
     currentGameResult = GameResult::ONGOING;
     currentEndReason = GameEndReason::NONE;
     
@@ -179,8 +178,8 @@ void GameController::resetGame() {
     }
     
     // Reset MoveValidator with new board
-    moveValidator = std::make_unique<MoveValidator>(&chessBoard);
-    gameEndEvaluator = std::make_unique<GameEndEvaluator>(&chessBoard, moveValidator.get());
+    moveValidator = std::make_unique<MoveValidator>(&chessBoard.getPosition());
+    gameEndEvaluator = std::make_unique<GameEndEvaluator>(&chessBoard.getGameRecord(), moveValidator.get());
     
     // Clear king danger status on reset
     chessBoard.clearKingDangerStatus();
@@ -238,14 +237,16 @@ void GameController::update(float deltaTime) {
         }
     }
     
-    // Update AI system - only if AI is thinking
+    // Update AI system - the search runs on a worker thread, its move is played once ready
     if (aiThinking && aiEnabled) {
-        aiThinkingTimer -= deltaTime;
-        if (aiThinkingTimer <= 0.0f) {
-            // AI finished thinking
-            processAIMove();
-            aiThinking = false;
-        }
+        processAIMove();
+    }
+    
+    // Analysis follows the game: any new position (move, undo, reset) restarts it.
+    // Not during a pending promotion: the pawn still stands on the last rank
+    if (analysisEngine && currentGameState != GameState::PAWN_PROMOTION_PENDING
+        && chessBoard.getPosition().key() != analysisKey) {
+        restartAnalysis();
     }
 }
 
@@ -258,7 +259,7 @@ void GameController::calculateLegalMoves(int row, int col) {
     }
 
     // Calcul silencieux des mouvements légaux
-    MoveValidator validator(&chessBoard);
+    MoveValidator validator(&chessBoard.getPosition());
     std::vector<Move> validMoves = validator.getValidMovesForPiece(row, col);
     
     for (const Move& move : validMoves) {
@@ -343,17 +344,15 @@ bool GameController::selectPiece(int row, int col) {
                 
                 // Exécuter le mouvement du pion (sans promotion)
                 Move moveToValidate(selectedPieceRow, selectedPieceCol, row, col);
-                const ChessPiece* targetPiece = chessBoard.getPieceAt(row, col);
-                if (targetPiece && !targetPiece->type.empty()) {
-                    moveToValidate.capturedType = targetPiece->type;
-                    moveToValidate.capturedColor = targetPiece->color;
-                }
+                Piece target = chessBoard.getPosition().pieceOn(squareAt(row, col));
+                moveToValidate.capturedType = typeOf(target);
+                moveToValidate.capturedColor = colorOf(target);
                 
-                MoveValidator validator(&chessBoard);
+                MoveValidator validator(&chessBoard.getPosition());
                 if (validator.isMoveLegal(moveToValidate)) {
                     // Exécuter le mouvement SANS promotion automatique
                     // On utilise un flag temporaire pour empêcher la promotion dans movePiece
-                    if (chessBoard.movePiece(selectedPieceRow, selectedPieceCol, row, col, "")) {
+                    if (chessBoard.movePiece(selectedPieceRow, selectedPieceCol, row, col, PieceType::None)) {
                         // Entrer dans l'état de promotion en attente
                         currentGameState = GameState::PAWN_PROMOTION_PENDING;
                         pendingPromotionRow = row;
@@ -378,13 +377,11 @@ bool GameController::selectPiece(int row, int col) {
             
             // Mouvement normal (pas de promotion)
             Move moveToValidate(selectedPieceRow, selectedPieceCol, row, col);
-            const ChessPiece* targetPiece = chessBoard.getPieceAt(row, col);
-            if (targetPiece && !targetPiece->type.empty()) {
-                moveToValidate.capturedType = targetPiece->type;
-                moveToValidate.capturedColor = targetPiece->color;
-            }
+            Piece target = chessBoard.getPosition().pieceOn(squareAt(row, col));
+            moveToValidate.capturedType = typeOf(target);
+            moveToValidate.capturedColor = colorOf(target);
             
-            MoveValidator validator(&chessBoard);
+            MoveValidator validator(&chessBoard.getPosition());
             if (validator.isMoveLegal(moveToValidate) && 
                 chessBoard.movePiece(selectedPieceRow, selectedPieceCol, row, col)) {
                 
@@ -392,7 +389,7 @@ bool GameController::selectPiece(int row, int col) {
                 std::cout << "[Move] " << currentPlayerColor << " moved (" 
                           << selectedPieceRow << "," << selectedPieceCol 
                           << ") → (" << row << "," << col << ")"
-                          << " [captured: " << moveToValidate.capturedType << "]"
+                          << " [captured: " << toString(moveToValidate.capturedType) << "]"
                           << std::endl;
                 
                 // Play move sound
@@ -455,11 +452,11 @@ bool GameController::selectPiece(int row, int col) {
 }
 
 bool GameController::isPawnPromotionRequired(int fromRow, int fromCol, int toRow, int toCol) const {
-    const ChessPiece* pawn = chessBoard.getPieceAt(fromRow, fromCol);
-    if (pawn && pawn->type == "pawn") {
-        if (pawn->color == "white" && toRow == 0) {
+    Piece pawn = chessBoard.getPosition().pieceOn(squareAt(fromRow, fromCol));
+    if (typeOf(pawn) == PieceType::Pawn) {
+        if (colorOf(pawn) == Color::White && toRow == 0) {
             return true;
-        } else if (pawn->color == "black" && toRow == 7) {
+        } else if (colorOf(pawn) == Color::Black && toRow == 7) {
             return true;
         }
     }
@@ -476,7 +473,7 @@ void GameController::executePawnPromotion(const std::string& promotionPiece) {
               << " at (" << pendingPromotionRow << "," << pendingPromotionCol << ")" << std::endl;
     
     // Promote the pawn
-    chessBoard.promotePawn(pendingPromotionRow, pendingPromotionCol, promotionPiece);
+    chessBoard.promotePawn(pendingPromotionRow, pendingPromotionCol, pieceTypeFromString(promotionPiece));
     
     // Switch turn NOW (after promotion is complete)
     whiteTurn = !whiteTurn;
@@ -521,8 +518,7 @@ bool GameController::undoMove() {
         selectedPieceCol = -1;
         clearLegalMoves();
         gameEnded = false;
-        aiThinking = false;
-        aiThinkingTimer = 0.0f;
+        cancelAIThinking();
         
         // Switch chess clock back to current player after undo
         if (whiteTurn) {
@@ -546,7 +542,7 @@ bool GameController::undoMove() {
 
 void GameController::pauseGame() {
     gamePaused = true;
-    aiThinking = false;
+    cancelAIThinking();
     chessClock.pauseAll();
     std::cout << "[GameController] Game paused - clocks stopped" << std::endl;
 }
@@ -564,6 +560,11 @@ void GameController::resumeGame() {
     
     std::cout << "[GameController] Game resumed - clock restarted for " 
               << (whiteTurn ? "white" : "black") << std::endl;
+    
+    // The search was cancelled by the pause: start it again
+    if (aiEnabled && isAITurn() && !gameEnded) {
+        startAIThinking();
+    }
 }
 
 void GameController::updateGameScore() {
@@ -597,8 +598,8 @@ void GameController::updateKingDangerStatus() {
     if (!moveValidator) return;
     
     // Check current check status for both kings
-    bool whiteInCheck = moveValidator->isInCheck("white");
-    bool blackInCheck = moveValidator->isInCheck("black");
+    bool whiteInCheck = moveValidator->isInCheck(Color::White);
+    bool blackInCheck = moveValidator->isInCheck(Color::Black);
     
     // Detect WHITE king entering check (state transition)
     if (whiteInCheck && !whiteWasInCheck) {
@@ -615,14 +616,16 @@ void GameController::updateKingDangerStatus() {
     blackWasInCheck = blackInCheck;
     
     // Update danger status for visual highlighting
-    chessBoard.updateKingDangerStatus("white", moveValidator.get());
-    chessBoard.updateKingDangerStatus("black", moveValidator.get());
+    chessBoard.updateKingDangerStatus(Color::White, moveValidator.get());
+    chessBoard.updateKingDangerStatus(Color::Black, moveValidator.get());
 }
 
 void GameController::evaluateGameEnd() {
     if (gameEnded || !gameEndEvaluator) return;
     
-    std::string currentColor = whiteTurn ? "white" : "black";
+    Color currentColor = whiteTurn ? Color::White : Color::Black;
+    // Contre l'IA, une finale résolue par les bitbases termine la partie
+    gameEndEvaluator->setBitbases(aiEnabled ? bitbases : nullptr);
     GameResult result = gameEndEvaluator->evaluateGameState(currentColor);
     
     if (result != GameResult::ONGOING) {
@@ -648,6 +651,9 @@ void GameController::evaluateGameEnd() {
 }
 
 void GameController::handleGameEnd(const std::string& winnerName, const std::string& loserName) {
+    // Timeout or result while the AI is searching: its move is no longer wanted
+    cancelAIThinking();
+    
     std::cout << "[GameController] Handling game end - Winner: " << winnerName << ", Loser: " << loserName << std::endl;
     
     // Record game result if scoreSystem exists
@@ -662,6 +668,12 @@ void GameController::recordGameResult(const std::string& winner, const std::stri
 }
 
 std::string GameController::getPositionEvaluation() {
+    // Analysis running: its best line replaces the static material count
+    SearchProgress analysis = getAnalysis();
+    if (analysis.depth > 0) {
+        return "depth " + std::to_string(analysis.depth) + ": " + analysis.score + " " + analysis.pv;
+    }
+    
     if (!scoreSystem) return "";
     return scoreSystem->evaluatePosition(chessBoard);
 }
@@ -674,26 +686,128 @@ bool GameController::isAITurn() const {
 }
 
 void GameController::startAIThinking() {
-    if (!aiEnabled || !isAITurn()) {
+    if (!aiEnabled || !isAITurn() || !aiEngine) {
         return;
     }
     
     aiThinking = true;
-    aiThinkingTimer = static_cast<float>(rand() % 3 + 2); // 2-5 seconds
     
-    std::cout << "[AI] Starting to think for " << aiThinkingTimer << " seconds..." << std::endl;
+    // Budget affiché: limite souple tirée de la pendule de l'IA
+    float remaining = getAIClock().remainingSeconds;
+    aiThinkingTimer = static_cast<float>(SearchLimits::fromClock(remaining).softTime);
+    
+    // Ponder: coup attendu joué, la recherche en cours devient celle du coup (itérations gardées);
+    // sinon elle est abandonnée, la table de transposition réchauffée reste
+    if (aiPondering) {
+        aiPondering = false;
+        if (aiEngine->ponderHit(chessBoard.getPosition())) {
+            std::cout << "[AI] Ponder hit - continuing the search (about " << aiThinkingTimer << "s of "
+                      << remaining << "s on the clock)..." << std::endl;
+            return;
+        }
+        std::cout << "[AI] Ponder miss - starting a new search" << std::endl;
+        aiEngine->cancelSearch();
+    }
+    
+    std::cout << "[AI] Starting to think (about " << aiThinkingTimer << "s of "
+              << remaining << "s on the clock)..." << std::endl;
+    
+    // Recherche sur un thread de travail, sur une copie de la position
+    aiEngine->setClockTime(remaining);
+    aiEngine->setGameHistory(chessBoard.getPositionHistory());
+    aiSearch = aiEngine->startSearch(chessBoard.getPosition(), colorFromString(aiColor));
+}
+
+void GameController::cancelAIThinking() {
+    if (aiEngine) {
+        aiEngine->cancelSearch();
+    }
+    aiSearch = std::future<Move>();
+    aiThinking = false;
+    aiPondering = false;
+    aiThinkingTimer = 0.0f;
+}
+
+void GameController::startAIPondering() {
+    if (!ponderEnabled || !aiEnabled || !aiEngine || isAITurn() || gameEnded || gamePaused) {
+        return;
+    }
+    
+    // Pendule de l'IA arrêtée pendant le tour du joueur: son temps restant est le budget du prochain coup
+    aiEngine->setClockTime(getAIClock().remainingSeconds);
+    aiEngine->setGameHistory(chessBoard.getPositionHistory());
+    aiSearch = aiEngine->startPondering(chessBoard.getPosition(), colorFromString(aiColor));
+    aiPondering = aiSearch.valid();
+    if (aiPondering) {
+        std::cout << "[AI] Pondering on " << toUciString(aiEngine->ponderMove()) << std::endl;
+    }
+}
+
+void GameController::setPonderEnabled(bool enable) {
+    ponderEnabled = enable;
+    if (!enable && aiPondering) {
+        cancelAIThinking();
+    }
+}
+
+SearchProgress GameController::getAIProgress() const {
+    return aiEngine ? aiEngine->getProgress() : SearchProgress();
+}
+
+void GameController::startAnalysis(int lineCount) {
+    analysisLines = std::max(1, lineCount);
+    if (!analysisEngine) {
+        // Level 3 engine with its own transposition table, shared across iterations and lines
+        analysisEngine = createAIEngine(3);
+    }
+    std::cout << "[GameController] Analysis started (" << analysisLines << " lines)" << std::endl;
+    restartAnalysis();
+}
+
+void GameController::stopAnalysis() {
+    if (!analysisEngine) return;
+    analysisEngine->cancelSearch();
+    analysisSearch = std::future<SearchProgress>();
+    analysisEngine.reset();
+    std::cout << "[GameController] Analysis stopped" << std::endl;
+}
+
+void GameController::restartAnalysis() {
+    // Promotion en attente: update() relance l'analyse une fois la pièce choisie
+    if (currentGameState == GameState::PAWN_PROMOTION_PENDING) return;
+
+    // startAnalysis() annule d'abord l'analyse de la position précédente
+    const Position& position = chessBoard.getPosition();
+    analysisKey = position.key();
+    analysisEngine->setGameHistory(chessBoard.getPositionHistory());
+    analysisSearch = analysisEngine->startAnalysis(position, analysisLines);
+}
+
+SearchProgress GameController::getAnalysis() const {
+    return analysisEngine ? analysisEngine->getProgress() : SearchProgress();
+}
+
+const PlayerClock& GameController::getAIClock() const {
+    return aiColor == "white" ? chessClock.getWhiteClock() : chessClock.getBlackClock();
 }
 
 void GameController::processAIMove() {
-    if (!aiEngine) {
-        std::cout << "[AI] ERROR: AI engine not initialized" << std::endl;
+    if (!aiEngine || !aiSearch.valid()) {
+        std::cout << "[AI] ERROR: no AI search in progress" << std::endl;
+        aiThinking = false;
         return;
     }
     
-    std::cout << "[AI] Processing move..." << std::endl;
+    // Still searching: keep rendering, check again next frame
+    if (aiSearch.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
     
-    // Get AI move from engine using chooseMove
-    Move aiMove = aiEngine->chooseMove(chessBoard, aiColor);
+    Move aiMove = aiSearch.get();
+    aiThinking = false;
+    aiThinkingTimer = 0.0f;
+    
+    std::cout << "[AI] Processing move..." << std::endl;
     
     if (aiMove.fromRow == -1) {
         std::cout << "[AI] No valid moves available!" << std::endl;
@@ -705,13 +819,16 @@ void GameController::processAIMove() {
 }
 
 void GameController::executeAIMove(const Move& move) {
-    MoveValidator validator(&chessBoard);
+    MoveValidator validator(&chessBoard.getPosition());
     if (!validator.isMoveLegal(move)) {
         std::cout << "[AI] ERROR: Illegal move suggested!" << std::endl;
         return;
     }
     
-    if (chessBoard.movePiece(move.fromRow, move.fromCol, move.toRow, move.toCol)) {
+    // Sous-promotion choisie par la recherche (cavalier, tour, fou) jouée telle quelle;
+    // dame par défaut si le coup ne précise pas la pièce
+    PieceType promotion = move.promotionPiece != PieceType::None ? move.promotionPiece : PieceType::Queen;
+    if (chessBoard.movePiece(move.fromRow, move.fromCol, move.toRow, move.toCol, promotion)) {
         std::cout << "[AI] Move executed successfully: (" << move.fromRow << "," << move.fromCol 
                   << ") -> (" << move.toRow << "," << move.toCol << ")" << std::endl;
         
@@ -742,6 +859,9 @@ void GameController::executeAIMove(const Move& move) {
         // Update score after AI move
         updateGameScore();
         
+        // Use the player's thinking time: search the expected reply in the background
+        startAIPondering();
+        
     } else {
         std::cout << "[AI] ERROR: Move execution failed" << std::endl;
     }
@@ -761,12 +881,14 @@ void GameController::enableAI(bool enable, const std::string& color) {
         initializeAI();
     } else {
         std::cout << "[GameController] AI disabled" << std::endl;
+        cancelAIThinking();
         aiEngine.reset();
     }
 }
 
 void GameController::disableAI() {
     aiEnabled = false;
+    cancelAIThinking();
     aiEngine.reset();
     std::cout << "[GameController] AI disabled" << std::endl;
 }
@@ -775,7 +897,9 @@ void GameController::initializeAI() {
     if (!aiEnabled) return;
     
     // Use the factory function to create AI engine based on difficulty
+    cancelAIThinking();
     aiEngine = createAIEngine(selectedDifficulty);
+    if (!bitbases) bitbases = EndgameBitbases::openShared(DEFAULT_BITBASE_DIR);
     std::cout << "[GameController] AI initialized with difficulty " << selectedDifficulty << std::endl;
     
     // If AI plays white, start thinking immediately
@@ -787,21 +911,21 @@ void GameController::initializeAI() {
 bool GameController::isCurrentPlayerInCheck() const {
     if (!moveValidator) return false;
     
-    std::string currentColor = whiteTurn ? "white" : "black";
+    Color currentColor = whiteTurn ? Color::White : Color::Black;
     return moveValidator->isInCheck(currentColor);
 }
 
 bool GameController::isCurrentPlayerInCheckmate() const {
     if (!moveValidator) return false;
     
-    std::string currentColor = whiteTurn ? "white" : "black";
+    Color currentColor = whiteTurn ? Color::White : Color::Black;
     return moveValidator->isCheckmate(currentColor);
 }
 
 bool GameController::isStalemate() const {
     if (!moveValidator) return false;
     
-    std::string currentColor = whiteTurn ? "white" : "black";
+    Color currentColor = whiteTurn ? Color::White : Color::Black;
     return moveValidator->isStalemate(currentColor);
 }
 
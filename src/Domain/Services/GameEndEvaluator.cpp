@@ -1,28 +1,27 @@
 #include "Services/GameEndEvaluator.h"
-#include "ChessBoard.h"
+#include "Services/EndgameBitbases.h"
+#include "Entities/GameRecord.h"
 #include "Rules/MoveValidator.h"
-#include "Entities/ChessPiece.h"
-#include <sstream>
+#include "Entities/Position.h"
 #include <iostream>
 
-GameEndEvaluator::GameEndEvaluator(const ChessBoard* board, const MoveValidator* validator)
-    : m_board(board)
+GameEndEvaluator::GameEndEvaluator(const GameRecord* game, const MoveValidator* validator)
+    : m_game(game)
     , m_validator(validator)
     , m_currentResult(GameResult::ONGOING)
-    , m_endReason(GameEndReason::NONE)
-    , m_halfMoveClock(0) {
+    , m_endReason(GameEndReason::NONE) {
 }
 
-GameResult GameEndEvaluator::evaluateGameState(const std::string& currentPlayerColor) {
+GameResult GameEndEvaluator::evaluateGameState(Color currentPlayer) {
     // Vérifier d'abord l'échec et mat (priorité la plus haute)
-    if (isCheckmate(currentPlayerColor)) {
-        m_currentResult = (currentPlayerColor == "white") ? GameResult::BLACK_WIN : GameResult::WHITE_WIN;
+    if (isCheckmate(currentPlayer)) {
+        m_currentResult = (currentPlayer == Color::White) ? GameResult::BLACK_WIN : GameResult::WHITE_WIN;
         m_endReason = GameEndReason::CHECKMATE;
         return m_currentResult;
     }
     
     // Vérifier le pat
-    if (isStalemate(currentPlayerColor)) {
+    if (isStalemate(currentPlayer)) {
         m_currentResult = GameResult::DRAW;
         m_endReason = GameEndReason::STALEMATE;
         return m_currentResult;
@@ -49,24 +48,32 @@ GameResult GameEndEvaluator::evaluateGameState(const std::string& currentPlayerC
         return m_currentResult;
     }
     
+    // Finale résolue: inutile de la jouer jusqu'au mat
+    GameResult adjudicated;
+    if (isAdjudicated(currentPlayer, adjudicated)) {
+        m_currentResult = adjudicated;
+        m_endReason = GameEndReason::ADJUDICATION;
+        return m_currentResult;
+    }
+    
     // La partie continue
     m_currentResult = GameResult::ONGOING;
     m_endReason = GameEndReason::NONE;
     return m_currentResult;
 }
 
-bool GameEndEvaluator::isCheckmate(const std::string& playerColor) const {
+bool GameEndEvaluator::isCheckmate(Color color) const {
     if (!m_validator) return false;
-    return m_validator->isCheckmate(playerColor);
+    return m_validator->isCheckmate(color);
 }
 
-bool GameEndEvaluator::isStalemate(const std::string& playerColor) const {
+bool GameEndEvaluator::isStalemate(Color color) const {
     if (!m_validator) return false;
-    return m_validator->isStalemate(playerColor);
+    return m_validator->isStalemate(color);
 }
 
 bool GameEndEvaluator::hasInsufficientMaterial() const {
-    if (!m_board) return false;
+    if (!m_game) return false;
     
     // Roi vs Roi
     if (hasOnlyKings()) {
@@ -92,19 +99,32 @@ bool GameEndEvaluator::hasInsufficientMaterial() const {
 }
 
 bool GameEndEvaluator::isFiftyMoveRule() const {
+    if (!m_game) return false;
     // La règle des 50 coups signifie 100 demi-coups (50 coups complets)
-    return m_halfMoveClock >= 100;
+    return m_game->halfMoveClock() >= 100;
 }
 
 bool GameEndEvaluator::isThreefoldRepetition() const {
-    std::string currentHash = generatePositionHash();
+    if (!m_game) return false;
+    // Comparaison de clés Zobrist depuis le dernier coup irréversible
+    return m_game->repetitionCount() >= 3;
+}
+
+bool GameEndEvaluator::isAdjudicated(Color currentPlayer, GameResult& result) const {
+    if (!m_game || !m_bitbases) return false;
     
-    auto it = m_positionHistory.find(currentHash);
-    if (it != m_positionHistory.end()) {
-        return it->second >= 3;
-    }
+    Position position = m_game->position();
+    if (position.sideToMove() != currentPlayer) position.setSideToMove(currentPlayer);
+    Wdl wdl;
+    if (!m_bitbases->probe(position, wdl)) return false;
     
-    return false;
+    if (wdl == Wdl::Draw) {
+        result = GameResult::DRAW;
+    } else {
+        bool whiteWins = (wdl == Wdl::Win) == (currentPlayer == Color::White);
+        result = whiteWins ? GameResult::WHITE_WIN : GameResult::BLACK_WIN;
+    }
+    return true;
 }
 
 std::string GameEndEvaluator::getResultDescription() const {
@@ -117,6 +137,8 @@ std::string GameEndEvaluator::getResultDescription() const {
                     return "White wins by resignation!";
                 case GameEndReason::TIMEOUT:
                     return "White wins on time!";
+                case GameEndReason::ADJUDICATION:
+                    return "White wins by adjudication (won endgame)!";
                 default:
                     return "White wins!";
             }
@@ -129,6 +151,8 @@ std::string GameEndEvaluator::getResultDescription() const {
                     return "Black wins by resignation!";
                 case GameEndReason::TIMEOUT:
                     return "Black wins on time!";
+                case GameEndReason::ADJUDICATION:
+                    return "Black wins by adjudication (won endgame)!";
                 default:
                     return "Black wins!";
             }
@@ -143,6 +167,8 @@ std::string GameEndEvaluator::getResultDescription() const {
                     return "Draw by fifty-move rule";
                 case GameEndReason::THREEFOLD_REPETITION:
                     return "Draw by threefold repetition";
+                case GameEndReason::ADJUDICATION:
+                    return "Draw by adjudication (drawn endgame)";
                 default:
                     return "Draw";
             }
@@ -153,92 +179,42 @@ std::string GameEndEvaluator::getResultDescription() const {
     }
 }
 
-void GameEndEvaluator::updateAfterMove(bool isPawnMove, bool isCapture) {
-    // Réinitialiser le compteur si c'est un mouvement de pion ou une capture
-    if (isPawnMove || isCapture) {
-        m_halfMoveClock = 0;
-    } else {
-        m_halfMoveClock++;
-    }
-}
-
-void GameEndEvaluator::recordCurrentPosition() {
-    std::string positionHash = generatePositionHash();
-    m_positionHistory[positionHash]++;
-}
-
 void GameEndEvaluator::reset() {
     m_currentResult = GameResult::ONGOING;
     m_endReason = GameEndReason::NONE;
-    m_halfMoveClock = 0;
-    m_positionHistory.clear();
 }
 
-std::string GameEndEvaluator::generatePositionHash() const {
-    if (!m_board) return "";
-    
-    std::stringstream ss;
-    
-    // Encoder la position de toutes les pièces
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const ChessPiece* piece = m_board->getPieceAt(row, col);
-            if (piece && !piece->type.empty()) {
-                ss << row << col << piece->type[0] << piece->color[0] << "|";
-            }
+namespace {
+    // Cases claires au sens du GUI: (row + col) pair
+    Bitboard lightSquares() {
+        Bitboard light = 0;
+        for (int square = 0; square < SQUARE_COUNT; square++) {
+            if ((rowOf(square) + colOf(square)) % 2 == 0) light |= squareBB(square);
         }
+        return light;
     }
-    
-    // Note: Pour une implémentation complète, il faudrait aussi encoder:
-    // - Le joueur actif
-    // - Les droits de roque
-    // - La possibilité de prise en passant
-    // Pour le moment, on se concentre sur la position des pièces
-    
-    return ss.str();
+
+    const Bitboard LIGHT_SQUARES = lightSquares();
 }
 
 bool GameEndEvaluator::hasOnlyKings() const {
-    int totalPieces = 0;
-    int kingCount = 0;
-    
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const ChessPiece* piece = m_board->getPieceAt(row, col);
-            if (piece && !piece->type.empty()) {
-                totalPieces++;
-                if (piece->type == "king") {
-                    kingCount++;
-                }
-            }
-        }
-    }
-    
-    return totalPieces == 2 && kingCount == 2;
+    const Position& position = m_game->position();
+    return position.pieces() == position.pieces(PieceType::King) && popCount(position.pieces()) == 2;
 }
 
 bool GameEndEvaluator::hasKingVsKingBishop() const {
-    int whiteKing = countPieces("king", "white");
-    int blackKing = countPieces("king", "black");
+    const Position& position = m_game->position();
     
-    int whiteBishop = countPieces("bishop", "white");
-    int blackBishop = countPieces("bishop", "black");
+    int whiteKing = countPieces(PieceType::King, Color::White);
+    int blackKing = countPieces(PieceType::King, Color::Black);
     
-    int whiteOther = 0;
-    int blackOther = 0;
+    int whiteBishop = countPieces(PieceType::Bishop, Color::White);
+    int blackBishop = countPieces(PieceType::Bishop, Color::Black);
     
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const ChessPiece* piece = m_board->getPieceAt(row, col);
-            if (piece && !piece->type.empty() && piece->type != "king" && piece->type != "bishop") {
-                if (piece->color == "white") whiteOther++;
-                else blackOther++;
-            }
-        }
-    }
+    Bitboard others = position.pieces() & ~position.pieces(PieceType::King) & ~position.pieces(PieceType::Bishop);
     
     // Roi + Fou vs Roi
-    if (whiteKing == 1 && blackKing == 1 && whiteOther == 0 && blackOther == 0) {
+    if (whiteKing == 1 && blackKing == 1 && others == 0) {
         return (whiteBishop == 1 && blackBishop == 0) || (whiteBishop == 0 && blackBishop == 1);
     }
     
@@ -246,27 +222,18 @@ bool GameEndEvaluator::hasKingVsKingBishop() const {
 }
 
 bool GameEndEvaluator::hasKingVsKingKnight() const {
-    int whiteKing = countPieces("king", "white");
-    int blackKing = countPieces("king", "black");
+    const Position& position = m_game->position();
     
-    int whiteKnight = countPieces("knight", "white");
-    int blackKnight = countPieces("knight", "black");
+    int whiteKing = countPieces(PieceType::King, Color::White);
+    int blackKing = countPieces(PieceType::King, Color::Black);
     
-    int whiteOther = 0;
-    int blackOther = 0;
+    int whiteKnight = countPieces(PieceType::Knight, Color::White);
+    int blackKnight = countPieces(PieceType::Knight, Color::Black);
     
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const ChessPiece* piece = m_board->getPieceAt(row, col);
-            if (piece && !piece->type.empty() && piece->type != "king" && piece->type != "knight") {
-                if (piece->color == "white") whiteOther++;
-                else blackOther++;
-            }
-        }
-    }
+    Bitboard others = position.pieces() & ~position.pieces(PieceType::King) & ~position.pieces(PieceType::Knight);
     
     // Roi + Cavalier vs Roi
-    if (whiteKing == 1 && blackKing == 1 && whiteOther == 0 && blackOther == 0) {
+    if (whiteKing == 1 && blackKing == 1 && others == 0) {
         return (whiteKnight == 1 && blackKnight == 0) || (whiteKnight == 0 && blackKnight == 1);
     }
     
@@ -274,45 +241,24 @@ bool GameEndEvaluator::hasKingVsKingKnight() const {
 }
 
 bool GameEndEvaluator::hasKingBishopVsKingBishop() const {
-    int whiteKing = countPieces("king", "white");
-    int blackKing = countPieces("king", "black");
-    
-    int whiteBishop = countPieces("bishop", "white");
-    int blackBishop = countPieces("bishop", "black");
+    const Position& position = m_game->position();
     
     // Vérifier qu'il n'y a que des rois et fous
-    int totalPieces = 0;
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const ChessPiece* piece = m_board->getPieceAt(row, col);
-            if (piece && !piece->type.empty()) {
-                totalPieces++;
-                if (piece->type != "king" && piece->type != "bishop") {
-                    return false;
-                }
-            }
-        }
+    if (position.pieces() & ~position.pieces(PieceType::King) & ~position.pieces(PieceType::Bishop)) {
+        return false;
     }
     
+    int whiteKing = countPieces(PieceType::King, Color::White);
+    int blackKing = countPieces(PieceType::King, Color::Black);
+    
+    int whiteBishop = countPieces(PieceType::Bishop, Color::White);
+    int blackBishop = countPieces(PieceType::Bishop, Color::Black);
+    
     // Roi + Fou vs Roi + Fou (exactement 4 pièces)
     if (whiteKing == 1 && blackKing == 1 && whiteBishop == 1 && blackBishop == 1) {
         // Vérifier si les deux fous sont sur la même couleur de case
-        bool whiteBishopOnLight = false;
-        bool blackBishopOnLight = false;
-        
-        for (int row = 0; row < 8; row++) {
-            for (int col = 0; col < 8; col++) {
-                const ChessPiece* piece = m_board->getPieceAt(row, col);
-                if (piece && piece->type == "bishop") {
-                    bool isLightSquare = ((row + col) % 2 == 0);
-                    if (piece->color == "white") {
-                        whiteBishopOnLight = isLightSquare;
-                    } else {
-                        blackBishopOnLight = isLightSquare;
-                    }
-                }
-            }
-        }
+        bool whiteBishopOnLight = (position.pieces(Color::White, PieceType::Bishop) & LIGHT_SQUARES) != 0;
+        bool blackBishopOnLight = (position.pieces(Color::Black, PieceType::Bishop) & LIGHT_SQUARES) != 0;
         
         return whiteBishopOnLight == blackBishopOnLight;
     }
@@ -320,35 +266,14 @@ bool GameEndEvaluator::hasKingBishopVsKingBishop() const {
     return false;
 }
 
-int GameEndEvaluator::countPieces(const std::string& type, const std::string& color) const {
-    int count = 0;
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const ChessPiece* piece = m_board->getPieceAt(row, col);
-            if (piece && piece->type == type && piece->color == color) {
-                count++;
-            }
-        }
-    }
-    return count;
+int GameEndEvaluator::countPieces(PieceType type, Color color) const {
+    return m_game->position().count(color, type);
 }
 
-bool GameEndEvaluator::allBishopsOnSameColorSquares(const std::string& color) const {
-    bool hasLightSquareBishop = false;
-    bool hasDarkSquareBishop = false;
-    
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const ChessPiece* piece = m_board->getPieceAt(row, col);
-            if (piece && piece->type == "bishop" && piece->color == color) {
-                if ((row + col) % 2 == 0) {
-                    hasLightSquareBishop = true;
-                } else {
-                    hasDarkSquareBishop = true;
-                }
-            }
-        }
-    }
+bool GameEndEvaluator::allBishopsOnSameColorSquares(Color color) const {
+    Bitboard bishops = m_game->position().pieces(color, PieceType::Bishop);
+    bool hasLightSquareBishop = (bishops & LIGHT_SQUARES) != 0;
+    bool hasDarkSquareBishop = (bishops & ~LIGHT_SQUARES) != 0;
     
     // Tous sur la même couleur si on n'a qu'un seul type
     return hasLightSquareBishop != hasDarkSquareBishop;
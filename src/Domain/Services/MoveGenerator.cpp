@@ -1,454 +1,331 @@
 #include "MoveGenerator.h"
-#include "ChessBoard.h"
-#include "Entities/ChessPiece.h"
+#include "Entities/Position.h"
+#include "Move.h"
 #include "Color.h"
-#include <cctype>
-#include <iostream>
 
-MoveGenerator::MoveGenerator(const ChessBoard* board) : m_board(board) {}
+MoveGenerator::MoveGenerator(const Position& position) : m_position(position) {}
 
-std::vector<Move> MoveGenerator::generateMovesForPiece(int row, int col) const {
-    std::vector<Move> moves;
-    if (!m_board || !m_board->isInsideBoard(row, col)) return moves;
-    const ChessPiece* p = m_board->getPieceAt(row, col);
-    if (!p || p->type.empty()) return moves;
-
-    // Use the full type string, not just the first character
-    const std::string& pieceType = p->type;
-    std::cout << "[MoveGenerator] Generating moves for piece type: '" << pieceType << "'" << std::endl;
-    
-    if (pieceType == "pawn") {
-        generatePawnMoves(row, col, moves);
-    } else if (pieceType == "knight") {
-        std::cout << "[MoveGenerator] Found knight! Generating knight moves..." << std::endl;
-        generateKnightMoves(row, col, moves);
-    } else if (pieceType == "bishop") {
-        generateBishopMoves(row, col, moves);
-    } else if (pieceType == "rook") {
-        generateRookMoves(row, col, moves);
-    } else if (pieceType == "queen") {
-        generateQueenMoves(row, col, moves);
-    } else if (pieceType == "king") {
-        generateKingMoves(row, col, moves);
-    } else {
-        std::cout << "[MoveGenerator] Unknown piece type: '" << pieceType << "'" << std::endl;
+void MoveGenerator::generateMoves(Color color, MoveList& moves) const {
+    Bitboard own = m_position.pieces(color);
+    while (own) {
+        generateMovesFrom(popLsb(own), moves);
     }
-    
-    std::cout << "[MoveGenerator] Generated " << moves.size() << " total moves for " << pieceType << std::endl;
-    return moves;
 }
 
-std::vector<Move> MoveGenerator::generateMovesForColor(Color color) const {
-    std::vector<Move> moves;
-    if (!m_board) return moves;
-    
-    std::string colorStr = (color == Color::White) ? "white" : "black";
-    
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const ChessPiece* piece = m_board->getPieceAt(row, col);
-            if (piece && piece->color == colorStr && !piece->type.empty()) {
-                std::vector<Move> pieceMoves = generateMovesForPiece(row, col);
-                moves.insert(moves.end(), pieceMoves.begin(), pieceMoves.end());
-            }
-        }
-    }
-    return moves;
-}
+void MoveGenerator::generateMovesFrom(int square, MoveList& moves) const {
+    Piece piece = m_position.pieceOn(square);
+    if (piece == NO_PIECE) return;
 
-bool MoveGenerator::isSquareAttacked(int row, int col, Color attacker) const {
-    if (!m_board || !m_board->isInsideBoard(row, col)) return false;
-    
-    std::string attackerColor = (attacker == Color::White) ? "white" : "black";
-    
-    for (int r = 0; r < 8; r++) {
-        for (int c = 0; c < 8; c++) {
-            const ChessPiece* piece = m_board->getPieceAt(r, c);
-            if (piece && piece->color == attackerColor && !piece->type.empty()) {
-                if (canPieceAttackSquare(r, c, row, col)) {
-                    return true;
-                }
-            }
-        }
+    if (typeOf(piece) == PieceType::Pawn) {
+        generatePawnMoves(square, moves);
+        return;
     }
-    return false;
-}
 
-bool MoveGenerator::canPieceAttackSquare(int fromRow, int fromCol, int toRow, int toCol) const {
-    const ChessPiece* piece = m_board->getPieceAt(fromRow, fromCol);
-    if (!piece || piece->type.empty()) return false;
-
-    // Use full piece type string
-    const std::string& pieceType = piece->type;
-    
-    if (pieceType == "pawn") {
-        return canPawnAttack(fromRow, fromCol, toRow, toCol, piece->color);
-    } else if (pieceType == "knight") {
-        return canKnightAttack(fromRow, fromCol, toRow, toCol);
-    } else if (pieceType == "bishop") {
-        return canBishopAttack(fromRow, fromCol, toRow, toCol);
-    } else if (pieceType == "rook") {
-        return canRookAttack(fromRow, fromCol, toRow, toCol);
-    } else if (pieceType == "queen") {
-        return canQueenAttack(fromRow, fromCol, toRow, toCol);
-    } else if (pieceType == "king") {
-        return canKingAttack(fromRow, fromCol, toRow, toCol);
+    // Toutes les autres pièces: cases attaquées moins nos propres pièces
+    addMoves(square, attacksFrom(square) & ~m_position.pieces(colorOf(piece)), moves);
+
+    if (typeOf(piece) == PieceType::King) {
+        generateCastlingMoves(square, moves);
     }
-    
-    return false;
 }
 
-void MoveGenerator::generatePawnMoves(int row, int col, std::vector<Move>& out) const {
-    const ChessPiece* pawn = m_board->getPieceAt(row, col);
-    if (!pawn || pawn->type.empty()) return;
-    
-    bool isWhite = (pawn->color == "white");
-    int direction = isWhite ? -1 : 1; // White moves up (negative), black moves down (positive)
-    int startRow = isWhite ? 6 : 1;   // Starting position for pawns
-    int promotionRow = isWhite ? 0 : 7; // Promotion row
-    
-    std::cout << "[MoveGenerator] Generating pawn moves for " << pawn->color 
-              << " pawn at (" << row << "," << col << ")" << std::endl;
-    
-    // Forward move (one square)
-    int newRow = row + direction;
-    if (m_board->isInsideBoard(newRow, col)) {
-        const ChessPiece* target = m_board->getPieceAt(newRow, col);
-        if (!target || target->type.empty()) {
-            // Check for promotion
-            if (newRow == promotionRow) {
-                // Add promotion moves for all piece types
-                std::string promotionPieces[] = {"queen", "rook", "bishop", "knight"};
-                for (const std::string& promotePiece : promotionPieces) {
-                    out.emplace_back(row, col, newRow, col, "", "", false, 
-                                   SpecialMoveType::PawnPromotion, promotePiece);
-                }
-            } else {
-                out.emplace_back(row, col, newRow, col);
-            }
-            
-            // Forward move (two squares from starting position)
-            if (row == startRow) {
-                int newRow2 = row + 2 * direction;
-                if (m_board->isInsideBoard(newRow2, col)) {
-                    const ChessPiece* target2 = m_board->getPieceAt(newRow2, col);
-                    if (!target2 || target2->type.empty()) {
-                        out.emplace_back(row, col, newRow2, col);
-                    }
-                }
-            }
+void MoveGenerator::generateLegalMoves(Color color, MoveList& moves, MoveGenType type) const {
+    int king = m_position.kingSquare(color);
+    if (king == NO_SQUARE) {
+        // Position d'édition sans roi: rien à protéger
+        if (type == MoveGenType::All) {
+            generateMoves(color, moves);
+            return;
         }
+        MoveList all;
+        generateMoves(color, all);
+        for (PackedMove move : all) {
+            if (isTactical(move) == (type == MoveGenType::Captures)) moves.add(move);
+        }
+        return;
     }
-    
-    // Diagonal captures
-    for (int colOffset = -1; colOffset <= 1; colOffset += 2) {
-        int newCol = col + colOffset;
-        if (m_board->isInsideBoard(newRow, newCol)) {
-            const ChessPiece* target = m_board->getPieceAt(newRow, newCol);
-            if (target && !target->type.empty() && target->color != pawn->color) {
-                // Check for promotion on capture
-                if (newRow == promotionRow) {
-                    std::string promotionPieces[] = {"queen", "rook", "bishop", "knight"};
-                    for (const std::string& promotePiece : promotionPieces) {
-                        out.emplace_back(row, col, newRow, newCol, target->type, target->color, 
-                                       false, SpecialMoveType::PawnPromotion, promotePiece);
-                    }
-                } else {
-                    out.emplace_back(row, col, newRow, newCol, target->type, target->color);
-                }
-            }
+
+    Color them = opposite(color);
+    Bitboard own = m_position.pieces(color);
+    Bitboard enemies = m_position.pieces(them);
+    Bitboard occupied = m_position.pieces();
+    Bitboard checkers = m_position.attackersTo(king, occupied) & enemies;
+
+    // Cases d'arrivée du type demandé (pièces autres que les pions)
+    Bitboard typeMask = type == MoveGenType::Captures ? enemies
+                      : type == MoveGenType::Quiets ? ~occupied : ~own;
+
+    // Roi: la case d'arrivée ne doit pas être attaquée une fois le roi parti
+    // (sinon il pourrait reculer le long du rayon d'une pièce glissante)
+    Bitboard kingTargets = Bitboards::kingAttacks(king) & ~own & typeMask;
+    Bitboard occupiedWithoutKing = occupied ^ squareBB(king);
+    while (kingTargets) {
+        int to = popLsb(kingTargets);
+        if (!(m_position.attackersTo(to, occupiedWithoutKing) & enemies)) {
+            moves.add(PackedMove(king, to));
         }
     }
-    
-    // TODO: En passant would need game state tracking
-    std::cout << "[MoveGenerator] Generated " << out.size() << " pawn moves" << std::endl;
-}
 
-void MoveGenerator::generateKnightMoves(int row, int col, std::vector<Move>& out) const {
-    const ChessPiece* knight = m_board->getPieceAt(row, col);
-    if (!knight || knight->type.empty()) return;
-    
-    std::cout << "[MoveGenerator] Generating knight moves for " << knight->color 
-              << " knight at (" << row << "," << col << ")" << std::endl;
-    
-    // Knight L-shaped moves: 8 possible moves
-    int knightMoves[8][2] = {
-        {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
-        {1, -2}, {1, 2}, {2, -1}, {2, 1}
-    };
-    
-    int validMoves = 0;
-    for (int i = 0; i < 8; i++) {
-        int newRow = row + knightMoves[i][0];
-        int newCol = col + knightMoves[i][1];
-        
-        if (m_board->isInsideBoard(newRow, newCol)) {
-            const ChessPiece* target = m_board->getPieceAt(newRow, newCol);
-            if (!target || target->type.empty()) {
-                // Empty square
-                out.emplace_back(row, col, newRow, newCol);
-                validMoves++;
-                std::cout << "[MoveGenerator] Knight can move to empty square (" << newRow << "," << newCol << ")" << std::endl;
-            } else if (target->color != knight->color) {
-                // Enemy piece
-                out.emplace_back(row, col, newRow, newCol, target->type, target->color);
-                validMoves++;
-                std::cout << "[MoveGenerator] Knight can capture " << target->type << " at (" << newRow << "," << newCol << ")" << std::endl;
-            } else {
-                std::cout << "[MoveGenerator] Knight blocked by own " << target->type << " at (" << newRow << "," << newCol << ")" << std::endl;
-            }
+    // Échec double: seul le roi peut bouger
+    if (moreThanOne(checkers)) return;
+
+    // En échec simple: prendre la pièce qui donne échec ou s'interposer
+    Bitboard targetMask = checkers ? (Bitboards::between(king, lsb(checkers)) | checkers) : ~own;
+    targetMask &= ~own;
+
+    Bitboard pinned = pinnedPieces(color, king);
+    Bitboard others = own & ~squareBB(king);
+    while (others) {
+        int from = popLsb(others);
+        // Une pièce clouée ne peut bouger que sur la ligne roi - cloueur
+        Bitboard pinMask = (pinned & squareBB(from)) ? Bitboards::line(king, from) : ~0ULL;
+
+        if (typeOf(m_position.pieceOn(from)) == PieceType::Pawn) {
+            generateLegalPawnMoves(from, targetMask, pinMask, checkers, type, moves);
         } else {
-            std::cout << "[MoveGenerator] Knight move (" << newRow << "," << newCol << ") is out of bounds" << std::endl;
+            addMoves(from, attacksFrom(from) & targetMask & pinMask & typeMask, moves);
         }
     }
-    
-    std::cout << "[MoveGenerator] Generated " << validMoves << " knight moves" << std::endl;
-}
 
-void MoveGenerator::generateKingMoves(int row, int col, std::vector<Move>& out) const {
-    const ChessPiece* king = m_board->getPieceAt(row, col);
-    if (!king || king->type.empty()) return;
-    
-    // King moves: 8 possible directions (1 square each)
-    int kingMoves[8][2] = {
-        {-1, -1}, {-1, 0}, {-1, 1},
-        {0, -1},           {0, 1},
-        {1, -1}, {1, 0}, {1, 1}
-    };
-    
-    for (int i = 0; i < 8; i++) {
-        int newRow = row + kingMoves[i][0];
-        int newCol = col + kingMoves[i][1];
-        
-        if (m_board->isInsideBoard(newRow, newCol)) {
-            const ChessPiece* target = m_board->getPieceAt(newRow, newCol);
-            if (!target || target->type.empty()) {
-                // Empty square - check if it's not under attack
-                Color enemyColor = (king->color == "white") ? Color::Black : Color::White;
-                if (!isSquareAttacked(newRow, newCol, enemyColor)) {
-                    out.emplace_back(row, col, newRow, newCol);
-                }
-            } else if (target->color != king->color) {
-                // Enemy piece - check if square is not under attack after capture
-                Color enemyColor = (king->color == "white") ? Color::Black : Color::White;
-                if (!isSquareAttacked(newRow, newCol, enemyColor)) {
-                    out.emplace_back(row, col, newRow, newCol, target->type, target->color);
-                }
-            }
-        }
+    if (!checkers && type != MoveGenType::Captures) {
+        generateCastlingMoves(king, moves);
     }
-    
-    // TODO: Add castling logic
-    generateCastlingMoves(row, col, out);
 }
 
-void MoveGenerator::generateCastlingMoves(int row, int col, std::vector<Move>& out) const {
-    const ChessPiece* king = m_board->getPieceAt(row, col);
-    if (!king || king->type.empty() || king->type != "king") return;
-    
-    // Can't castle if king has moved
-    if (king->hasMoved) return;
-    
-    bool isWhite = (king->color == "white");
-    Color enemyColor = isWhite ? Color::Black : Color::White;
-    
-    // Can't castle if in check
-    if (isSquareAttacked(row, col, enemyColor)) return;
-    
-    // Check kingside castling
-    if (canCastle(row, col, true)) {
-        out.emplace_back(row, col, row, col + 2, "", "", false, SpecialMoveType::Castling);
-    }
-    
-    // Check queenside castling
-    if (canCastle(row, col, false)) {
-        out.emplace_back(row, col, row, col - 2, "", "", false, SpecialMoveType::Castling);
-    }
+bool MoveGenerator::isTactical(PackedMove move) const {
+    return move.isPromotion() || move.flag() == EN_PASSANT_MOVE
+        || (move.flag() != CASTLING_MOVE && !m_position.isEmpty(move.to()));
 }
 
-bool MoveGenerator::canCastle(int kingRow, int kingCol, bool kingside) const {
-    const ChessPiece* king = m_board->getPieceAt(kingRow, kingCol);
-    if (!king || king->hasMoved) return false;
-    
-    bool isWhite = (king->color == "white");
-    Color enemyColor = isWhite ? Color::Black : Color::White;
-    
-    int rookCol = kingside ? 7 : 0;
-    const ChessPiece* rook = m_board->getPieceAt(kingRow, rookCol);
-    
-    // Check if rook exists and hasn't moved
-    if (!rook || rook->type != "rook" || rook->color != king->color || rook->hasMoved) {
-        return false;
+bool MoveGenerator::isLegal(PackedMove move) const {
+    if (move.isNull()) return false;
+    Piece piece = m_position.pieceOn(move.from());
+    if (piece == NO_PIECE || colorOf(piece) != m_position.sideToMove()) return false;
+
+    MoveList moves;
+    generateMovesFrom(move.from(), moves);
+    if (!moves.contains(move)) return false;
+
+    Position after = m_position;
+    after.applyMove(move);
+    return !after.isInCheck(colorOf(piece));
+}
+
+Bitboard MoveGenerator::pinnedPieces(Color color, int kingSquare) const {
+    Color them = opposite(color);
+    Bitboard occupied = m_position.pieces();
+    Bitboard queens = m_position.pieces(them, PieceType::Queen);
+
+    // Pièces glissantes adverses alignées avec le roi sur un échiquier vide
+    Bitboard snipers = (Bitboards::rookAttacks(kingSquare, 0) & (m_position.pieces(them, PieceType::Rook) | queens))
+                     | (Bitboards::bishopAttacks(kingSquare, 0) & (m_position.pieces(them, PieceType::Bishop) | queens));
+
+    Bitboard pinned = 0;
+    while (snipers) {
+        Bitboard blockers = Bitboards::between(kingSquare, popLsb(snipers)) & occupied;
+        if (blockers && !moreThanOne(blockers)) {
+            pinned |= blockers & m_position.pieces(color);
+        }
     }
-    
-    // Check if path is clear
-    int direction = kingside ? 1 : -1;
-    int endCol = kingside ? rookCol - 1 : rookCol + 1;
-    
-    for (int col = kingCol + direction; col != endCol + direction; col += direction) {
-        const ChessPiece* piece = m_board->getPieceAt(kingRow, col);
-        if (piece && !piece->type.empty()) {
-            return false; // Path blocked
+    return pinned;
+}
+
+void MoveGenerator::generateLegalPawnMoves(int square, Bitboard targetMask, Bitboard pinMask,
+                                           Bitboard checkers, MoveGenType type, MoveList& moves) const {
+    Color us = colorOf(m_position.pieceOn(square));
+    int forward = (us == Color::White) ? 8 : -8;
+    int startRank = (us == Color::White) ? 1 : 6;
+    Bitboard allowed = targetMask & pinMask;
+
+    // Pion sur sa dernière rangée (position illégale): aucun coup, et pas de case hors de l'échiquier
+    int oneStep = square + forward;
+    if (oneStep < 0 || oneStep >= SQUARE_COUNT) return;
+
+    // Les promotions, même sans prise, sont rangées avec les prises
+    bool promotes = rankOf(oneStep) == 7 || rankOf(oneStep) == 0;
+    bool wantPushes = promotes ? type != MoveGenType::Quiets : type != MoveGenType::Captures;
+    if (m_position.isEmpty(oneStep) && wantPushes) {
+        if (allowed & squareBB(oneStep)) {
+            addPawnMove(square, oneStep, moves);
         }
-        
-        // Check if king would pass through or end up in check
-        if (abs(col - kingCol) <= 2) { // Only check squares king passes through
-            if (isSquareAttacked(kingRow, col, enemyColor)) {
-                return false; // King would be in check
-            }
+
+        int twoSteps = oneStep + forward;
+        if (rankOf(square) == startRank && m_position.isEmpty(twoSteps) && (allowed & squareBB(twoSteps))) {
+            moves.add(PackedMove(square, twoSteps));
         }
     }
-    
-    return true;
+
+    if (type == MoveGenType::Quiets) return;
+
+    Bitboard attacks = Bitboards::pawnAttacks(us, square);
+    Bitboard captures = attacks & m_position.pieces(opposite(us)) & allowed;
+    while (captures) {
+        addPawnMove(square, popLsb(captures), moves);
+    }
+
+    int epSquare = m_position.enPassantSquare();
+    if (epSquare != NO_SQUARE && m_position.sideToMove() == us && (attacks & squareBB(epSquare))
+        && isLegalEnPassant(square, checkers)) {
+        moves.add(PackedMove(square, epSquare, EN_PASSANT_MOVE));
+    }
 }
 
-void MoveGenerator::generateRookMoves(int row, int col, std::vector<Move>& out) const {
-    const ChessPiece* rook = m_board->getPieceAt(row, col);
-    if (!rook || rook->type.empty()) return;
-    
-    // Rook moves: 4 directions (horizontal and vertical)
-    int directions[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
-    
-    for (int dir = 0; dir < 4; dir++) {
-        int rowStep = directions[dir][0];
-        int colStep = directions[dir][1];
-        
-        for (int step = 1; step < 8; step++) {
-            int newRow = row + step * rowStep;
-            int newCol = col + step * colStep;
-            
-            if (!m_board->isInsideBoard(newRow, newCol)) break;
-            
-            const ChessPiece* target = m_board->getPieceAt(newRow, newCol);
-            if (!target || target->type.empty()) {
-                // Empty square
-                out.emplace_back(row, col, newRow, newCol);
-            } else {
-                if (target->color != rook->color) {
-                    // Enemy piece - can capture
-                    out.emplace_back(row, col, newRow, newCol, target->type, target->color);
-                }
-                // Blocked by any piece, stop in this direction
-                break;
-            }
-        }
+bool MoveGenerator::isLegalEnPassant(int from, Bitboard checkers) const {
+    Color us = colorOf(m_position.pieceOn(from));
+    Color them = opposite(us);
+    int kingSquare = m_position.kingSquare(us);
+    int to = m_position.enPassantSquare();
+    int capturedSquare = (us == Color::White) ? to - 8 : to + 8;
+
+    // En échec: la prise doit enlever la pièce qui donne échec ou s'interposer
+    if (checkers && !(checkers & squareBB(capturedSquare))
+        && !(Bitboards::between(kingSquare, lsb(checkers)) & squareBB(to))) {
+        return false;
     }
+
+    // Deux pions quittent la rangée d'un coup: on vérifie directement les rayons vers le roi
+    Bitboard occupied = (m_position.pieces() ^ squareBB(from) ^ squareBB(capturedSquare)) | squareBB(to);
+    Bitboard queens = m_position.pieces(them, PieceType::Queen);
+    return !(Bitboards::rookAttacks(kingSquare, occupied) & (m_position.pieces(them, PieceType::Rook) | queens))
+        && !(Bitboards::bishopAttacks(kingSquare, occupied) & (m_position.pieces(them, PieceType::Bishop) | queens));
 }
 
-void MoveGenerator::generateBishopMoves(int row, int col, std::vector<Move>& out) const {
-    const ChessPiece* bishop = m_board->getPieceAt(row, col);
-    if (!bishop || bishop->type.empty()) return;
-    
-    // Bishop moves: 4 diagonal directions
-    int directions[4][2] = {{-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
-    
-    for (int dir = 0; dir < 4; dir++) {
-        int rowStep = directions[dir][0];
-        int colStep = directions[dir][1];
-        
-        for (int step = 1; step < 8; step++) {
-            int newRow = row + step * rowStep;
-            int newCol = col + step * colStep;
-            
-            if (!m_board->isInsideBoard(newRow, newCol)) break;
-            
-            const ChessPiece* target = m_board->getPieceAt(newRow, newCol);
-            if (!target || target->type.empty()) {
-                // Empty square
-                out.emplace_back(row, col, newRow, newCol);
-            } else {
-                if (target->color != bishop->color) {
-                    // Enemy piece - can capture
-                    out.emplace_back(row, col, newRow, newCol, target->type, target->color);
-                }
-                // Blocked by any piece, stop in this direction
-                break;
-            }
-        }
+std::vector<Move> MoveGenerator::generateMovesForPiece(int row, int col) const {
+    MoveList moves;
+    if (row >= 0 && row < 8 && col >= 0 && col < 8) {
+        generateMovesFrom(squareAt(row, col), moves);
     }
+    return toLegacyMoves(moves);
 }
 
-void MoveGenerator::generateQueenMoves(int row, int col, std::vector<Move>& out) const {
-    // Queen moves like both rook and bishop
-    generateRookMoves(row, col, out);
-    generateBishopMoves(row, col, out);
+std::vector<Move> MoveGenerator::generateMovesForColor(Color color) const {
+    MoveList moves;
+    generateMoves(color, moves);
+    return toLegacyMoves(moves);
 }
 
-// Helper methods for attack detection
-bool MoveGenerator::canPawnAttack(int fromRow, int fromCol, int toRow, int toCol, const std::string& color) const {
-    int rowDiff = toRow - fromRow;
-    int colDiff = abs(toCol - fromCol);
-    
-    if (colDiff != 1) return false;
-    
-    if (color == "white") {
-        return rowDiff == -1;
-    } else {
-        return rowDiff == 1;
+std::vector<Move> MoveGenerator::toLegacyMoves(const MoveList& moves) const {
+    std::vector<Move> legacyMoves;
+    legacyMoves.reserve(moves.size());
+    for (PackedMove move : moves) {
+        legacyMoves.push_back(toLegacyMove(move, m_position));
     }
+    return legacyMoves;
 }
 
-bool MoveGenerator::canKnightAttack(int fromRow, int fromCol, int toRow, int toCol) const {
-    int rowDiff = abs(toRow - fromRow);
-    int colDiff = abs(toCol - fromCol);
-    return (rowDiff == 2 && colDiff == 1) || (rowDiff == 1 && colDiff == 2);
+bool MoveGenerator::isSquareAttacked(int row, int col, Color attacker) const {
+    if (row < 0 || row >= 8 || col < 0 || col >= 8) return false;
+    return m_position.isSquareAttacked(squareAt(row, col), attacker);
 }
 
-bool MoveGenerator::canBishopAttack(int fromRow, int fromCol, int toRow, int toCol) const {
-    return isDiagonalPath(fromRow, fromCol, toRow, toCol) && 
-           isPathClear(fromRow, fromCol, toRow, toCol);
+bool MoveGenerator::canPieceAttackSquare(int fromRow, int fromCol, int toRow, int toCol) const {
+    if (fromRow < 0 || fromRow >= 8 || fromCol < 0 || fromCol >= 8 ||
+        toRow < 0 || toRow >= 8 || toCol < 0 || toCol >= 8) {
+        return false;
+    }
+    return (attacksFrom(squareAt(fromRow, fromCol)) & squareBB(squareAt(toRow, toCol))) != 0;
 }
 
-bool MoveGenerator::canRookAttack(int fromRow, int fromCol, int toRow, int toCol) const {
-    return isStraightPath(fromRow, fromCol, toRow, toCol) && 
-           isPathClear(fromRow, fromCol, toRow, toCol);
-}
+Bitboard MoveGenerator::attacksFrom(int square) const {
+    Piece piece = m_position.pieceOn(square);
+    Bitboard occupied = m_position.pieces();
 
-bool MoveGenerator::canQueenAttack(int fromRow, int fromCol, int toRow, int toCol) const {
-    return (isDiagonalPath(fromRow, fromCol, toRow, toCol) || 
-            isStraightPath(fromRow, fromCol, toRow, toCol)) &&
-           isPathClear(fromRow, fromCol, toRow, toCol);
+    switch (typeOf(piece)) {
+        case PieceType::Pawn:   return Bitboards::pawnAttacks(colorOf(piece), square);
+        case PieceType::Knight: return Bitboards::knightAttacks(square);
+        case PieceType::Bishop: return Bitboards::bishopAttacks(square, occupied);
+        case PieceType::Rook:   return Bitboards::rookAttacks(square, occupied);
+        case PieceType::Queen:  return Bitboards::queenAttacks(square, occupied);
+        case PieceType::King:   return Bitboards::kingAttacks(square);
+        default:                return 0;
+    }
 }
 
-bool MoveGenerator::canKingAttack(int fromRow, int fromCol, int toRow, int toCol) const {
-    int rowDiff = abs(toRow - fromRow);
-    int colDiff = abs(toCol - fromCol);
-    return rowDiff <= 1 && colDiff <= 1 && (rowDiff != 0 || colDiff != 0);
+void MoveGenerator::addMoves(int from, Bitboard targets, MoveList& moves) const {
+    while (targets) {
+        moves.add(PackedMove(from, popLsb(targets)));
+    }
 }
 
-bool MoveGenerator::isDiagonalPath(int fromRow, int fromCol, int toRow, int toCol) const {
-    int rowDiff = abs(toRow - fromRow);
-    int colDiff = abs(toCol - fromCol);
-    return rowDiff == colDiff && rowDiff > 0;
+void MoveGenerator::generatePawnMoves(int square, MoveList& moves) const {
+    Color us = colorOf(m_position.pieceOn(square));
+    if (us == Color::None) return;  // Case vide: aucun coup (et pas d'index de couleur invalide)
+    int forward = (us == Color::White) ? 8 : -8;
+    int startRank = (us == Color::White) ? 1 : 6;
+
+    // Poussées d'une et de deux cases
+    int oneStep = square + forward;
+    if (oneStep >= 0 && oneStep < SQUARE_COUNT && m_position.isEmpty(oneStep)) {
+        addPawnMove(square, oneStep, moves);
+
+        int twoSteps = oneStep + forward;
+        if (rankOf(square) == startRank && m_position.isEmpty(twoSteps)) {
+            moves.add(PackedMove(square, twoSteps));
+        }
+    }
+
+    // Captures diagonales
+    Bitboard attacks = Bitboards::pawnAttacks(us, square);
+    Bitboard captures = attacks & m_position.pieces(opposite(us));
+    while (captures) {
+        addPawnMove(square, popLsb(captures), moves);
+    }
+
+    // Prise en passant (seulement pour le camp au trait)
+    int epSquare = m_position.enPassantSquare();
+    if (epSquare != NO_SQUARE && m_position.sideToMove() == us && (attacks & squareBB(epSquare))) {
+        moves.add(PackedMove(square, epSquare, EN_PASSANT_MOVE));
+    }
 }
 
-bool MoveGenerator::isStraightPath(int fromRow, int fromCol, int toRow, int toCol) const {
-    return (fromRow == toRow && fromCol != toCol) || (fromCol == toCol && fromRow != toRow);
+void MoveGenerator::addPawnMove(int from, int to, MoveList& moves) const {
+    if (rankOf(to) == 7 || rankOf(to) == 0) {
+        // Promotion: un coup par pièce possible
+        moves.add(PackedMove(from, to, PROMOTION_MOVE, PieceType::Queen));
+        moves.add(PackedMove(from, to, PROMOTION_MOVE, PieceType::Rook));
+        moves.add(PackedMove(from, to, PROMOTION_MOVE, PieceType::Bishop));
+        moves.add(PackedMove(from, to, PROMOTION_MOVE, PieceType::Knight));
+        return;
+    }
+    moves.add(PackedMove(from, to));
 }
 
-bool MoveGenerator::isPathClear(int fromRow, int fromCol, int toRow, int toCol) const {
-    if (!m_board) return false;
-    
-    int rowStep = 0, colStep = 0;
-    
-    if (toRow != fromRow) {
-        rowStep = (toRow > fromRow) ? 1 : -1;
+void MoveGenerator::generateCastlingMoves(int square, MoveList& moves) const {
+    Color us = colorOf(m_position.pieceOn(square));
+
+    // Can't castle if in check
+    if (m_position.isSquareAttacked(square, opposite(us))) return;
+
+    if (canCastle(square, true)) {
+        moves.add(PackedMove(square, square + 2, CASTLING_MOVE));
     }
-    if (toCol != fromCol) {
-        colStep = (toCol > fromCol) ? 1 : -1;
+    if (canCastle(square, false)) {
+        moves.add(PackedMove(square, square - 2, CASTLING_MOVE));
     }
-    
-    int currentRow = fromRow + rowStep;
-    int currentCol = fromCol + colStep;
-    
-    while (currentRow != toRow || currentCol != toCol) {
-        const ChessPiece* piece = m_board->getPieceAt(currentRow, currentCol);
-        if (piece && !piece->type.empty()) {
-            return false; // Path is blocked
-        }
-        currentRow += rowStep;
-        currentCol += colStep;
+}
+
+bool MoveGenerator::canCastle(int kingSquare, bool kingside) const {
+    Color us = colorOf(m_position.pieceOn(kingSquare));
+    int homeRow = (us == Color::White) ? 7 : 0;
+    if (kingSquare != squareAt(homeRow, 4)) return false;
+
+    uint8_t right = (us == Color::White)
+        ? (kingside ? WHITE_KINGSIDE : WHITE_QUEENSIDE)
+        : (kingside ? BLACK_KINGSIDE : BLACK_QUEENSIDE);
+    if (!(m_position.castlingRights() & right)) return false;
+
+    int rookSquare = squareAt(homeRow, kingside ? 7 : 0);
+    if (m_position.pieceOn(rookSquare) != makePiece(us, PieceType::Rook)) return false;
+
+    // Les cases entre le roi et la tour doivent être vides
+    int step = kingside ? 1 : -1;
+    for (int square = kingSquare + step; square != rookSquare; square += step) {
+        if (!m_position.isEmpty(square)) return false;
+    }
+
+    // Le roi ne doit pas traverser ni atteindre une case attaquée
+    for (int square = kingSquare + step; square != kingSquare + 3 * step; square += step) {
+        if (m_position.isSquareAttacked(square, opposite(us))) return false;
     }
-    
-    return true; // Path is clear
+    return true;
 }
@@ -0,0 +1,173 @@
+#include "MovePicker.h"
+#include "MoveGenerator.h"
+#include <cstdlib>
+#include <utility>
+
+namespace {
+    // Ordre MVV-LVA: victime la plus chère d'abord, puis attaquant le moins cher
+    constexpr int ORDER_VALUES[PIECE_TYPE_COUNT + 1] = { 1, 3, 3, 5, 9, 10, 0 };
+
+    int captureScore(const Position& position, PackedMove move) {
+        int score = 0;
+        PieceType victim = typeOf(position.pieceOn(move.to()));
+        if (move.flag() == EN_PASSANT_MOVE) victim = PieceType::Pawn;
+        if (victim != PieceType::None) {
+            PieceType attacker = typeOf(position.pieceOn(move.from()));
+            score += 100 + ORDER_VALUES[toIndex(victim)] * 10 - ORDER_VALUES[toIndex(attacker)];
+        }
+        if (move.isPromotion()) score += 90 + ORDER_VALUES[toIndex(move.promotionType())];
+        return score;
+    }
+}
+
+void ButterflyHistory::update(Color color, PackedMove move, int bonus) {
+    int16_t& entry = m_table[toIndex(color)][move.from()][move.to()];
+    if (bonus > MAX_VALUE) bonus = MAX_VALUE;
+    if (bonus < -MAX_VALUE) bonus = -MAX_VALUE;
+    entry += static_cast<int16_t>(bonus - entry * std::abs(bonus) / MAX_VALUE);
+}
+
+void ButterflyHistory::clear() {
+    for (auto& byFrom : m_table) {
+        for (auto& byTo : byFrom) {
+            for (int16_t& entry : byTo) entry = 0;
+        }
+    }
+}
+
+void ButterflyHistory::age() {
+    for (auto& byFrom : m_table) {
+        for (auto& byTo : byFrom) {
+            for (int16_t& entry : byTo) entry /= 2;
+        }
+    }
+}
+
+MovePicker::MovePicker(const Position& position, PackedMove ttMove, const ButterflyHistory& history,
+                       const PackedMove* killers, PackedMove counterMove)
+    : m_position(position), m_history(history), m_ttMove(ttMove), m_counterMove(counterMove) {
+    m_inCheck = position.isInCheck(position.sideToMove());
+    if (killers) {
+        m_killers[0] = killers[0];
+        m_killers[1] = killers[1];
+    }
+    if (!m_ttMove.isNull() && !MoveGenerator(position).isLegal(m_ttMove)) m_ttMove = PackedMove();
+}
+
+MovePicker::MovePicker(const Position& position, const ButterflyHistory& history)
+    : m_position(position), m_history(history), m_quiescence(true) {
+    m_inCheck = position.isInCheck(position.sideToMove());
+    m_stage = Stage::GenerateCaptures;
+}
+
+PackedMove MovePicker::next() {
+    Color us = m_position.sideToMove();
+    MoveGenerator generator(m_position);
+
+    while (true) {
+        switch (m_stage) {
+        case Stage::TTMove:
+            m_stage = Stage::GenerateCaptures;
+            if (!m_ttMove.isNull()) return m_ttMove;
+            break;
+
+        case Stage::GenerateCaptures:
+            m_moves.clear();
+            generator.generateLegalMoves(us, m_moves, MoveGenType::Captures);
+            for (int i = 0; i < m_moves.size(); i++) {
+                m_scores[i] = captureScore(m_position, m_moves[i]);
+            }
+            m_current = 0;
+            m_stage = Stage::GoodCaptures;
+            break;
+
+        case Stage::GoodCaptures: {
+            PackedMove move = pickBest();
+            if (move.isNull()) {
+                // Quiescence hors échec: les coups calmes ne sont jamais générés
+                m_stage = m_quiescence && !m_inCheck ? Stage::Done
+                        : m_quiescence ? Stage::GenerateQuiets : Stage::Killer1;
+                break;
+            }
+            if (move == m_ttMove) break;
+
+            // Prise perdante: gardée pour la fin, ou abandonnée en quiescence
+            if (!m_inCheck && m_position.staticExchange(move) < 0) {
+                if (!m_quiescence) m_badCaptures.add(move);
+                break;
+            }
+            return move;
+        }
+
+        case Stage::Killer1:
+            m_stage = Stage::Killer2;
+            if (isValidSpecial(m_killers[0])) return m_killers[0];
+            break;
+
+        case Stage::Killer2:
+            m_stage = Stage::CounterMove;
+            if (m_killers[1] != m_killers[0] && isValidSpecial(m_killers[1])) return m_killers[1];
+            break;
+
+        case Stage::CounterMove:
+            m_stage = Stage::GenerateQuiets;
+            if (m_counterMove != m_killers[0] && m_counterMove != m_killers[1]
+                && isValidSpecial(m_counterMove)) {
+                return m_counterMove;
+            }
+            break;
+
+        case Stage::GenerateQuiets:
+            m_moves.clear();
+            generator.generateLegalMoves(us, m_moves, MoveGenType::Quiets);
+            for (int i = 0; i < m_moves.size(); i++) {
+                m_scores[i] = m_history.get(us, m_moves[i]);
+            }
+            m_current = 0;
+            m_stage = Stage::Quiets;
+            break;
+
+        case Stage::Quiets: {
+            PackedMove move = pickBest();
+            if (move.isNull()) {
+                m_stage = Stage::BadCaptures;
+                break;
+            }
+            if (move == m_ttMove || isRefutation(move)) break;
+            return move;
+        }
+
+        case Stage::BadCaptures:
+            if (m_badCurrent < m_badCaptures.size()) return m_badCaptures[m_badCurrent++];
+            m_stage = Stage::Done;
+            break;
+
+        case Stage::Done:
+            return PackedMove();
+        }
+    }
+}
+
+PackedMove MovePicker::pickBest() {
+    if (m_current >= m_moves.size()) return PackedMove();
+
+    // Sélection du meilleur restant: après une coupure, le reste n'est jamais trié
+    int best = m_current;
+    for (int i = m_current + 1; i < m_moves.size(); i++) {
+        if (m_scores[i] > m_scores[best]) best = i;
+    }
+    std::swap(m_moves[m_current], m_moves[best]);
+    std::swap(m_scores[m_current], m_scores[best]);
+    return m_moves[m_current++];
+}
+
+bool MovePicker::isRefutation(PackedMove move) const {
+    // Déjà rendus par leurs étapes (s'ils étaient légaux)
+    return !m_quiescence && (move == m_killers[0] || move == m_killers[1] || move == m_counterMove);
+}
+
+bool MovePicker::isValidSpecial(PackedMove move) const {
+    if (move.isNull() || move == m_ttMove) return false;
+    MoveGenerator generator(m_position);
+    return !generator.isTactical(move) && generator.isLegal(move);
+}
@@ -0,0 +1,189 @@
+#include "Nnue.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    using namespace Nnue;
+
+    // Case vue par perspective: les noirs voient l'échiquier retourné
+    constexpr int orient(Color perspective, int square) {
+        return perspective == Color::White ? square : square ^ 56;
+    }
+
+    template<typename T>
+    bool readValues(std::ifstream& file, std::vector<T>& values, size_t count) {
+        values.resize(count);
+        file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+        return static_cast<bool>(file);
+    }
+
+    void clipLayer(const int32_t* input, uint8_t* output, int size) {
+        for (int i = 0; i < size; i++) {
+            output[i] = static_cast<uint8_t>(std::clamp(input[i] >> WEIGHT_SHIFT, 0, ACTIVATION_MAX));
+        }
+    }
+}
+
+namespace Nnue {
+
+    int featureIndex(Color perspective, int kingSquare, Piece piece, int square) {
+        int pieceIndex = toIndex(typeOf(piece)) * 2 + (colorOf(piece) != perspective ? 1 : 0);
+        return orient(perspective, kingSquare) * PIECE_FEATURES + pieceIndex * SQUARE_COUNT + orient(perspective, square);
+    }
+
+    bool Network::load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            std::cout << "[Nnue] Cannot open " << path << std::endl;
+            return false;
+        }
+
+        char magic[4] = {};
+        uint32_t header[5] = {};
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (!file || std::memcmp(magic, "CMNN", 4) != 0 || header[0] != VERSION) {
+            std::cout << "[Nnue] " << path << ": not a network file (version " << VERSION << " expected)" << std::endl;
+            return false;
+        }
+        if (header[1] != INPUT_SIZE || header[2] != HALF_SIZE || header[3] != L1_SIZE || header[4] != L2_SIZE) {
+            std::cout << "[Nnue] " << path << ": architecture " << header[1] << "x" << header[2] << "x"
+                      << header[3] << "x" << header[4] << " not supported" << std::endl;
+            return false;
+        }
+
+        std::vector<int32_t> outputBias;
+        bool ok = readValues(file, m_featureBiases, HALF_SIZE)
+               && readValues(file, m_featureWeights, static_cast<size_t>(INPUT_SIZE) * HALF_SIZE)
+               && readValues(file, m_l1Biases, L1_SIZE)
+               && readValues(file, m_l1Weights, static_cast<size_t>(L1_SIZE) * 2 * HALF_SIZE)
+               && readValues(file, m_l2Biases, L2_SIZE)
+               && readValues(file, m_l2Weights, static_cast<size_t>(L2_SIZE) * L1_SIZE)
+               && readValues(file, outputBias, 1)
+               && readValues(file, m_outputWeights, L2_SIZE);
+        if (!ok) {
+            std::cout << "[Nnue] " << path << ": truncated file" << std::endl;
+            m_loaded = false;
+            return false;
+        }
+
+        m_outputBias = outputBias[0];
+        m_path = path;
+        m_loaded = true;
+        std::cout << "[Nnue] Loaded " << path << " (" << backendName(activeBackend()) << " kernels)" << std::endl;
+        return true;
+    }
+
+    void Network::refresh(const Position& position, Color perspective, Accumulator& accumulator) const {
+        const Kernels& kernel = kernels();
+        int16_t* values = accumulator.values[toIndex(perspective)];
+        std::copy(m_featureBiases.begin(), m_featureBiases.end(), values);
+
+        int king = position.kingSquare(perspective);
+        if (king == NO_SQUARE) king = 0;
+        Bitboard occupied = position.pieces() & ~position.pieces(PieceType::King);
+        while (occupied) {
+            int square = popLsb(occupied);
+            kernel.addWeights(values, featureWeights(featureIndex(perspective, king, position.pieceOn(square), square)));
+        }
+        accumulator.computed[toIndex(perspective)] = true;
+    }
+
+    int Network::evaluate(const Accumulator& accumulator, Color sideToMove) const {
+        const Kernels& kernel = kernels();
+        alignas(64) uint8_t input[2 * HALF_SIZE];
+        alignas(64) int32_t l1[L1_SIZE];
+        alignas(64) uint8_t l1Output[L1_SIZE];
+        alignas(64) int32_t l2[L2_SIZE];
+        alignas(64) uint8_t l2Output[L2_SIZE];
+
+        // Camp au trait d'abord: le réseau sait ainsi qui joue
+        kernel.clippedRelu(accumulator.values[toIndex(sideToMove)], input);
+        kernel.clippedRelu(accumulator.values[toIndex(opposite(sideToMove))], input + HALF_SIZE);
+
+        kernel.affine(input, 2 * HALF_SIZE, m_l1Weights.data(), m_l1Biases.data(), l1, L1_SIZE);
+        clipLayer(l1, l1Output, L1_SIZE);
+        kernel.affine(l1Output, L1_SIZE, m_l2Weights.data(), m_l2Biases.data(), l2, L2_SIZE);
+        clipLayer(l2, l2Output, L2_SIZE);
+
+        int32_t output = m_outputBias;
+        for (int i = 0; i < L2_SIZE; i++) output += l2Output[i] * m_outputWeights[i];
+        return output / OUTPUT_SCALE;
+    }
+
+    int Network::evaluate(const Position& position) const {
+        Accumulator accumulator;
+        refresh(position, Color::White, accumulator);
+        refresh(position, Color::Black, accumulator);
+        return evaluate(accumulator, position.sideToMove());
+    }
+
+    AccumulatorStack::AccumulatorStack() : m_levels(std::make_unique<Level[]>(MAX_PLY + 1)) {}
+
+    void AccumulatorStack::reset() {
+        m_top = 0;
+        m_levels[0].accumulator.computed[0] = m_levels[0].accumulator.computed[1] = false;
+        m_levels[0].dirtyCount = 0;
+    }
+
+    void AccumulatorStack::push(const StateInfo& state) {
+        Level& level = m_levels[++m_top];
+        level.accumulator.computed[0] = level.accumulator.computed[1] = false;
+        level.dirtyCount = state.dirtyCount;
+        std::copy(state.dirty, state.dirty + state.dirtyCount, level.dirty);
+    }
+
+    void AccumulatorStack::pop() {
+        m_top--;
+    }
+
+    int AccumulatorStack::evaluate(const Position& position) {
+        for (Color perspective : { Color::White, Color::Black }) {
+            if (!m_levels[m_top].accumulator.computed[toIndex(perspective)]) update(position, perspective);
+        }
+        return m_network->evaluate(m_levels[m_top].accumulator, position.sideToMove());
+    }
+
+    void AccumulatorStack::update(const Position& position, Color perspective) {
+        int index = toIndex(perspective);
+        Piece king = makePiece(perspective, PieceType::King);
+
+        // Dernier niveau calculé, à condition que le roi de la perspective n'ait pas bougé depuis
+        int source = m_top;
+        while (source > 0 && !m_levels[source].accumulator.computed[index]) {
+            const Level& level = m_levels[source];
+            bool kingMoved = std::any_of(level.dirty, level.dirty + level.dirtyCount,
+                                         [king](const StateInfo::DirtyPiece& dirty) { return dirty.piece == king; });
+            if (kingMoved) break;
+            source--;
+        }
+        if (!m_levels[source].accumulator.computed[index]) {
+            m_network->refresh(position, perspective, m_levels[m_top].accumulator);
+            return;
+        }
+
+        // Rejouer les différences niveau par niveau: les noeuds frères repartiront des intermédiaires
+        const Kernels& kernel = kernels();
+        int kingSquare = position.kingSquare(perspective);
+        if (kingSquare == NO_SQUARE) kingSquare = 0;
+        for (int ply = source + 1; ply <= m_top; ply++) {
+            Level& level = m_levels[ply];
+            int16_t* values = level.accumulator.values[index];
+            std::copy(m_levels[ply - 1].accumulator.values[index],
+                      m_levels[ply - 1].accumulator.values[index] + HALF_SIZE, values);
+            for (int i = 0; i < level.dirtyCount; i++) {
+                const StateInfo::DirtyPiece& dirty = level.dirty[i];
+                if (typeOf(dirty.piece) == PieceType::King) continue;  // Roi adverse: pas une entrée
+                if (dirty.from != NO_SQUARE) {
+                    kernel.subtractWeights(values, m_network->featureWeights(featureIndex(perspective, kingSquare, dirty.piece, dirty.from)));
+                }
+                if (dirty.to != NO_SQUARE) {
+                    kernel.addWeights(values, m_network->featureWeights(featureIndex(perspective, kingSquare, dirty.piece, dirty.to)));
+                }
+            }
+            level.accumulator.computed[index] = true;
+        }
+    }
+}
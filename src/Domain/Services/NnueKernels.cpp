@@ -0,0 +1,240 @@
+#include "Nnue.h"
+#include <algorithm>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NNUE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// Fonctions compilées pour un jeu d'instructions précis, appelées seulement s'il est
+// disponible. MSVC accepte les intrinsèques sans option; GCC et Clang les veulent par fonction.
+#if defined(__GNUC__)
+#define NNUE_TARGET(isa) __attribute__((target(isa)))
+#else
+#define NNUE_TARGET(isa)
+#endif
+
+namespace {
+    using namespace Nnue;
+
+    // ---- Scalaire ----
+
+    void addWeightsScalar(int16_t* accumulator, const int16_t* weights) {
+        for (int i = 0; i < HALF_SIZE; i++) accumulator[i] = static_cast<int16_t>(accumulator[i] + weights[i]);
+    }
+
+    void subtractWeightsScalar(int16_t* accumulator, const int16_t* weights) {
+        for (int i = 0; i < HALF_SIZE; i++) accumulator[i] = static_cast<int16_t>(accumulator[i] - weights[i]);
+    }
+
+    void clippedReluScalar(const int16_t* input, uint8_t* output) {
+        for (int i = 0; i < HALF_SIZE; i++) {
+            output[i] = static_cast<uint8_t>(std::clamp<int>(input[i], 0, ACTIVATION_MAX));
+        }
+    }
+
+    void affineScalar(const uint8_t* input, int inputSize, const int8_t* weights,
+                      const int32_t* biases, int32_t* output, int outputSize) {
+        for (int j = 0; j < outputSize; j++) {
+            const int8_t* row = weights + static_cast<size_t>(j) * inputSize;
+            int32_t sum = biases[j];
+            for (int i = 0; i < inputSize; i++) sum += input[i] * row[i];
+            output[j] = sum;
+        }
+    }
+
+    constexpr Kernels SCALAR_KERNELS = { addWeightsScalar, subtractWeightsScalar, clippedReluScalar, affineScalar };
+
+#ifdef NNUE_X86
+    // ---- SSE4.1 ----
+
+    NNUE_TARGET("sse4.1")
+    void addWeightsSse41(int16_t* accumulator, const int16_t* weights) {
+        for (int i = 0; i < HALF_SIZE; i += 8) {
+            __m128i* acc = reinterpret_cast<__m128i*>(accumulator + i);
+            __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i));
+            _mm_store_si128(acc, _mm_add_epi16(_mm_load_si128(acc), w));
+        }
+    }
+
+    NNUE_TARGET("sse4.1")
+    void subtractWeightsSse41(int16_t* accumulator, const int16_t* weights) {
+        for (int i = 0; i < HALF_SIZE; i += 8) {
+            __m128i* acc = reinterpret_cast<__m128i*>(accumulator + i);
+            __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i));
+            _mm_store_si128(acc, _mm_sub_epi16(_mm_load_si128(acc), w));
+        }
+    }
+
+    NNUE_TARGET("sse4.1")
+    void clippedReluSse41(const int16_t* input, uint8_t* output) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i max = _mm_set1_epi16(ACTIVATION_MAX);
+        for (int i = 0; i < HALF_SIZE; i += 16) {
+            __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(input + i));
+            __m128i b = _mm_load_si128(reinterpret_cast<const __m128i*>(input + i + 8));
+            a = _mm_min_epi16(_mm_max_epi16(a, zero), max);
+            b = _mm_min_epi16(_mm_max_epi16(b, zero), max);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packus_epi16(a, b));
+        }
+    }
+
+    // Entrées ≤ 127: maddubs (u8 × i8, paires sommées en i16) ne sature jamais, le résultat est exact.
+    // Quatre sorties à la fois: une seule réduction horizontale pour les quatre sommes.
+    NNUE_TARGET("sse4.1")
+    void affineSse41(const uint8_t* input, int inputSize, const int8_t* weights,
+                     const int32_t* biases, int32_t* output, int outputSize) {
+        const __m128i ones = _mm_set1_epi16(1);
+        for (int j = 0; j < outputSize; j += 4) {
+            __m128i sums[4];
+            for (int k = 0; k < 4; k++) {
+                const int8_t* row = weights + static_cast<size_t>(j + k) * inputSize;
+                __m128i sum = _mm_setzero_si128();
+                for (int i = 0; i < inputSize; i += 16) {
+                    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+                    __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+                    sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_maddubs_epi16(in, w), ones));
+                }
+                sums[k] = sum;
+            }
+            __m128i total = _mm_hadd_epi32(_mm_hadd_epi32(sums[0], sums[1]), _mm_hadd_epi32(sums[2], sums[3]));
+            total = _mm_add_epi32(total, _mm_loadu_si128(reinterpret_cast<const __m128i*>(biases + j)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + j), total);
+        }
+    }
+
+    constexpr Kernels SSE41_KERNELS = { addWeightsSse41, subtractWeightsSse41, clippedReluSse41, affineSse41 };
+
+    // ---- AVX2 ----
+
+    NNUE_TARGET("avx2")
+    void addWeightsAvx2(int16_t* accumulator, const int16_t* weights) {
+        for (int i = 0; i < HALF_SIZE; i += 16) {
+            __m256i* acc = reinterpret_cast<__m256i*>(accumulator + i);
+            __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i));
+            _mm256_store_si256(acc, _mm256_add_epi16(_mm256_load_si256(acc), w));
+        }
+    }
+
+    NNUE_TARGET("avx2")
+    void subtractWeightsAvx2(int16_t* accumulator, const int16_t* weights) {
+        for (int i = 0; i < HALF_SIZE; i += 16) {
+            __m256i* acc = reinterpret_cast<__m256i*>(accumulator + i);
+            __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i));
+            _mm256_store_si256(acc, _mm256_sub_epi16(_mm256_load_si256(acc), w));
+        }
+    }
+
+    NNUE_TARGET("avx2")
+    void clippedReluAvx2(const int16_t* input, uint8_t* output) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i max = _mm256_set1_epi16(ACTIVATION_MAX);
+        for (int i = 0; i < HALF_SIZE; i += 32) {
+            __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(input + i));
+            __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i*>(input + i + 16));
+            a = _mm256_min_epi16(_mm256_max_epi16(a, zero), max);
+            b = _mm256_min_epi16(_mm256_max_epi16(b, zero), max);
+            // packus travaille par moitié de 128 bits: on remet les quadruplets dans l'ordre
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), packed);
+        }
+    }
+
+    NNUE_TARGET("avx2")
+    void affineAvx2(const uint8_t* input, int inputSize, const int8_t* weights,
+                    const int32_t* biases, int32_t* output, int outputSize) {
+        const __m256i ones = _mm256_set1_epi16(1);
+        for (int j = 0; j < outputSize; j += 4) {
+            __m256i sums[4];
+            for (int k = 0; k < 4; k++) {
+                const int8_t* row = weights + static_cast<size_t>(j + k) * inputSize;
+                __m256i sum = _mm256_setzero_si256();
+                for (int i = 0; i < inputSize; i += 32) {
+                    __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+                    __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+                    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(in, w), ones));
+                }
+                sums[k] = sum;
+            }
+            // Par moitié de 128 bits: [Σ0, Σ1, Σ2, Σ3], puis somme des deux moitiés
+            __m256i total = _mm256_hadd_epi32(_mm256_hadd_epi32(sums[0], sums[1]), _mm256_hadd_epi32(sums[2], sums[3]));
+            __m128i result = _mm_add_epi32(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+            result = _mm_add_epi32(result, _mm_loadu_si128(reinterpret_cast<const __m128i*>(biases + j)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + j), result);
+        }
+    }
+
+    constexpr Kernels AVX2_KERNELS = { addWeightsAvx2, subtractWeightsAvx2, clippedReluAvx2, affineAvx2 };
+
+    bool cpuSupports(Backend backend) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+        __cpuid(info, 1);
+        bool sse41 = (info[2] & (1 << 19)) != 0;
+        if (backend == Backend::Sse41) return sse41;
+
+        // AVX2: bit du processeur, et registres YMM sauvegardés par le système (OSXSAVE + XCR0)
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        if (maxLeaf < 7 || !osxsave || (_xgetbv(0) & 0x6) != 0x6) return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        if (backend == Backend::Sse41) return __builtin_cpu_supports("sse4.1");
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#else
+    bool cpuSupports(Backend) { return false; }
+#endif
+
+    const Kernels* kernelsFor(Backend backend) {
+#ifdef NNUE_X86
+        if (backend == Backend::Avx2) return &AVX2_KERNELS;
+        if (backend == Backend::Sse41) return &SSE41_KERNELS;
+#endif
+        (void)backend;
+        return &SCALAR_KERNELS;
+    }
+
+    std::atomic<Backend>& selectedBackend() {
+        static std::atomic<Backend> backend{ detectBackend() };
+        return backend;
+    }
+}
+
+namespace Nnue {
+
+    Backend detectBackend() {
+        if (cpuSupports(Backend::Avx2)) return Backend::Avx2;
+        if (cpuSupports(Backend::Sse41)) return Backend::Sse41;
+        return Backend::Scalar;
+    }
+
+    void setBackend(Backend backend) {
+        if (backend != Backend::Scalar && !cpuSupports(backend)) backend = Backend::Scalar;
+        selectedBackend() = backend;
+    }
+
+    Backend activeBackend() {
+        return selectedBackend();
+    }
+
+    const char* backendName(Backend backend) {
+        switch (backend) {
+            case Backend::Avx2: return "AVX2";
+            case Backend::Sse41: return "SSE4.1";
+            default: return "scalar";
+        }
+    }
+
+    const Kernels& kernels() {
+        return *kernelsFor(selectedBackend());
+    }
+}
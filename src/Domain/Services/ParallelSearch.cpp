@@ -0,0 +1,92 @@
+#include "ParallelSearch.h"
+#include <algorithm>
+#include <thread>
+
+ParallelSearch::ParallelSearch(TranspositionTable& table, int threadCount) : m_table(table) {
+    setThreadCount(threadCount);
+}
+
+void ParallelSearch::setThreadCount(int threadCount) {
+    threadCount = std::clamp(threadCount, 1, 256);
+    m_searches.resize(threadCount);
+
+    for (int i = 0; i < threadCount; i++) {
+        if (!m_searches[i]) m_searches[i] = std::make_unique<Search>();
+        m_searches[i]->setTranspositionTable(&m_table);
+        m_searches[i]->setStopSignal(i == 0 ? m_abort : &m_stop);
+        m_searches[i]->setThreadIndex(i);
+        m_searches[i]->setOptions(m_options);
+        m_searches[i]->setNetwork(m_network);
+        m_searches[i]->setBitbases(m_bitbases);
+        m_searches[i]->setPonderSignal(m_pondering);
+    }
+    m_searches[0]->setProgressCallback(m_progressCallback);
+}
+
+void ParallelSearch::setOptions(const SearchOptions& options) {
+    m_options = options;
+    for (auto& search : m_searches) search->setOptions(m_options);
+}
+
+void ParallelSearch::setNetwork(const Nnue::Network* network) {
+    m_network = network;
+    for (auto& search : m_searches) search->setNetwork(m_network);
+}
+
+void ParallelSearch::setBitbases(const EndgameBitbases* bitbases) {
+    m_bitbases = bitbases;
+    for (auto& search : m_searches) search->setBitbases(m_bitbases);
+}
+
+void ParallelSearch::setAbortSignal(const std::atomic<bool>* abort) {
+    m_abort = abort;
+    m_searches[0]->setStopSignal(m_abort);
+}
+
+void ParallelSearch::setPonderSignal(const std::atomic<bool>* pondering) {
+    m_pondering = pondering;
+    for (auto& search : m_searches) search->setPonderSignal(m_pondering);
+}
+
+void ParallelSearch::setProgressCallback(Search::ProgressCallback callback) {
+    m_progressCallback = std::move(callback);
+    m_searches[0]->setProgressCallback(m_progressCallback);
+}
+
+SearchResult ParallelSearch::run(const Position& position, const SearchLimits& limits,
+                                 const std::vector<uint64_t>& history) {
+    m_table.newSearch();
+    m_stop.store(false, std::memory_order_relaxed);
+
+    std::vector<SearchResult> results(m_searches.size());
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < m_searches.size(); i++) {
+        helpers.emplace_back([this, i, &results, &position, &limits, &history]() {
+            results[i] = m_searches[i]->run(position, limits, history);
+        });
+    }
+
+    results[0] = m_searches[0]->run(position, limits, history);
+    m_stop.store(true, std::memory_order_relaxed);
+    for (std::thread& helper : helpers) helper.join();
+
+    // Coup de la plus grande profondeur terminée (depth ne compte pas une itération
+    // interrompue par l'arrêt): à égalité, celui du principal. Noeuds et statistiques cumulés.
+    // En MultiPV, les variations publiées sont celles du principal: on les garde.
+    SearchResult best = results[0];
+    uint64_t nodes = 0;
+    TTStatistics tt;
+    for (size_t i = 0; i < results.size(); i++) {
+        nodes += results[i].nodes;
+        tt += results[i].tt;
+        if (i > 0 && limits.multiPV <= 1 && !results[i].bestMove.isNull() && results[i].depth > best.depth) {
+            best = results[i];
+        }
+    }
+
+    best.nodes = nodes;
+    best.tt = tt;
+    best.seconds = results[0].seconds;
+    best.aborted = results[0].aborted;
+    return best;
+}
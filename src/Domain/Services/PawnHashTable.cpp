@@ -0,0 +1,139 @@
+#include "PawnHashTable.h"
+#include <algorithm>
+
+namespace {
+    constexpr PieceSquare::Score DOUBLED_PENALTY = { -10, -25 };   // Par pion en trop sur la colonne
+    constexpr PieceSquare::Score ISOLATED_PENALTY = { -10, -15 };
+    constexpr PieceSquare::Score BACKWARD_PENALTY = { -8, -12 };
+
+    // Pion passé selon sa rangée relative (rangée 2 à 7)
+    constexpr PieceSquare::Score PASSED_BONUS[8] = {
+        { 0, 0 }, { 5, 10 }, { 10, 15 }, { 15, 25 }, { 25, 45 }, { 40, 70 }, { 60, 110 }, { 0, 0 }
+    };
+
+    // Bouclier: pion devant le roi à une ou deux rangées, ou absent de la colonne
+    constexpr int SHIELD_CLOSE = 12;
+    constexpr int SHIELD_FAR = 6;
+    constexpr int SHIELD_MISSING = -12;
+
+    constexpr Bitboard fileMask(int file) { return FILE_A_BB << file; }
+
+    constexpr Bitboard adjacentFiles(int file) {
+        return (file > 0 ? fileMask(file - 1) : 0) | (file < 7 ? fileMask(file + 1) : 0);
+    }
+
+    // Rangées strictement devant square, dans le sens de marche de color
+    constexpr Bitboard forwardRanks(Color color, int square) {
+        int rank = rankOf(square);
+        if (color == Color::White) return rank == 7 ? 0 : ~0ULL << (8 * (rank + 1));
+        return rank == 0 ? 0 : (1ULL << (8 * rank)) - 1;
+    }
+
+    constexpr int relativeRank(Color color, int square) {
+        return color == Color::White ? rankOf(square) : 7 - rankOf(square);
+    }
+
+    PieceSquare::Score evaluateColor(const Position& position, Color color, Bitboard& passed) {
+        Color them = opposite(color);
+        Bitboard ours = position.pieces(color, PieceType::Pawn);
+        Bitboard theirs = position.pieces(them, PieceType::Pawn);
+        PieceSquare::Score score;
+        passed = 0;
+
+        for (int file = 0; file < 8; file++) {
+            int count = popCount(ours & fileMask(file));
+            if (count > 1) score += { DOUBLED_PENALTY.mg * (count - 1), DOUBLED_PENALTY.eg * (count - 1) };
+        }
+
+        Bitboard pawns = ours;
+        while (pawns) {
+            int square = popLsb(pawns);
+            int file = fileOf(square);
+            Bitboard front = forwardRanks(color, square);
+
+            // Passé: aucun pion adverse devant lui, sur sa colonne ni les colonnes voisines
+            // (le pion de derrière d'un pion doublé ne compte pas)
+            if (!(theirs & front & (fileMask(file) | adjacentFiles(file))) && !(ours & front & fileMask(file))) {
+                passed |= squareBB(square);
+                score += PASSED_BONUS[relativeRank(color, square)];
+            }
+
+            if (!(ours & adjacentFiles(file))) {
+                score += ISOLATED_PENALTY;
+                continue;
+            }
+
+            // Arriéré: aucun voisin à sa hauteur ou derrière, et sa case d'avance tenue par un pion adverse
+            int stop = color == Color::White ? square + 8 : square - 8;
+            bool supported = ours & adjacentFiles(file) & ~front;
+            if (!supported && stop >= 0 && stop < SQUARE_COUNT
+                && (Bitboards::pawnAttacks(color, stop) & theirs)) {
+                score += BACKWARD_PENALTY;
+            }
+        }
+        return score;
+    }
+}
+
+PieceSquare::Score PawnEntry::shield(const Position& position, Color color) {
+    int king = position.kingSquare(color);
+    int index = toIndex(color);
+    if (king == kingSquare[index]) return kingShield[index];
+
+    kingSquare[index] = king;
+    kingShield[index] = PieceSquare::Score();
+    if (king == NO_SQUARE) return kingShield[index];
+
+    // Milieu de partie seulement: en finale le roi doit sortir
+    Bitboard ours = position.pieces(color, PieceType::Pawn) & forwardRanks(color, king);
+    int kingFile = fileOf(king);
+    int bonus = 0;
+    for (int file = std::max(kingFile - 1, 0); file <= std::min(kingFile + 1, 7); file++) {
+        Bitboard onFile = ours & fileMask(file);
+        if (!onFile) {
+            bonus += SHIELD_MISSING;
+            continue;
+        }
+        int nearest = color == Color::White ? lsb(onFile) : msb(onFile);
+        int distance = relativeRank(color, nearest) - relativeRank(color, king);
+        bonus += distance == 1 ? SHIELD_CLOSE : distance == 2 ? SHIELD_FAR : 0;
+    }
+    kingShield[index].mg = bonus;
+    return kingShield[index];
+}
+
+PawnHashTable::PawnHashTable(size_t entries) {
+    size_t count = 1;
+    while (count * 2 <= entries) count *= 2;
+    m_entries = std::make_unique<PawnEntry[]>(count);
+    m_mask = count - 1;
+    clear();
+}
+
+void PawnHashTable::clear() {
+    // Clé 0 = position sans pions: l'entrée vide initiale est exacte pour elle
+    for (size_t i = 0; i <= m_mask; i++) m_entries[i] = PawnEntry();
+    m_probes = 0;
+    m_hits = 0;
+}
+
+PawnEntry& PawnHashTable::probe(const Position& position) {
+    uint64_t key = position.pawnKey();
+    PawnEntry& entry = m_entries[key & m_mask];
+    m_probes++;
+    if (entry.key == key) {
+        m_hits++;
+        return entry;
+    }
+
+    entry = PawnEntry();
+    entry.key = key;
+    evaluate(position, entry);
+    return entry;
+}
+
+void PawnHashTable::evaluate(const Position& position, PawnEntry& entry) {
+    for (Color color : { Color::White, Color::Black }) {
+        entry.scores[toIndex(color)] = evaluateColor(position, color, entry.passedPawns[toIndex(color)]);
+    }
+}
@@ -0,0 +1,637 @@
+#include "Search.h"
+#include "Evaluator.h"
+#include "MoveGenerator.h"
+#include "MovePicker.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+    // Gestion du temps (pendule sans incrément)
+    constexpr double CLOCK_SAFETY_MARGIN = 0.5;  // Latence de la boucle GUI, jamais consommée
+    constexpr double MOVES_TO_GO = 30.0;         // Coups restant à jouer supposés
+    constexpr double HARD_TO_SOFT_RATIO = 4.0;
+    constexpr double MAX_CLOCK_FRACTION = 0.25;  // Jamais plus d'un quart du temps restant
+    constexpr double MIN_THINK_TIME = 0.01;
+    constexpr int TIME_CHECK_INTERVAL = 1024;    // Noeuds entre deux lectures de l'horloge
+
+    // Lazy SMP: chaque thread auxiliaire saute une partie des profondeurs, selon un motif
+    // propre, pour que les threads ne recherchent pas tous la même itération en même temps
+    constexpr int SKIP_PATTERNS = 20;
+    constexpr int SKIP_SIZE[SKIP_PATTERNS] = { 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+    constexpr int SKIP_PHASE[SKIP_PATTERNS] = { 0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+    // Élagage sélectif (voir SearchOptions)
+    constexpr int REVERSE_FUTILITY_DEPTH = 6;
+    constexpr int REVERSE_FUTILITY_MARGIN = 80;  // Par demi-coup de profondeur restante
+    constexpr int FUTILITY_DEPTH = 3;
+    constexpr int FUTILITY_MARGINS[FUTILITY_DEPTH + 1] = { 0, 150, 300, 500 };
+    constexpr int NULL_MOVE_MIN_DEPTH = 3;
+    constexpr int NULL_MOVE_VERIFY_DEPTH = 10;   // Au-delà, coupure vérifiée sans coup nul
+    constexpr int LMR_MIN_DEPTH = 3;
+    constexpr int ASPIRATION_MIN_DEPTH = 4;
+    constexpr int ASPIRATION_DELTA = 25;
+
+    // Coups calmes retenus par noeud pour pénaliser ceux qui n'ont pas coupé
+    constexpr int MAX_QUIETS_TRIED = 64;
+
+    std::string movesToString(const std::vector<PackedMove>& moves) {
+        std::string text;
+        for (PackedMove move : moves) {
+            if (!text.empty()) text += ' ';
+            text += toUciString(move);
+        }
+        return text;
+    }
+
+    // Bonus d'historique d'une coupure à cette profondeur
+    int historyBonus(int depth) {
+        return std::min(depth * depth * 16, ButterflyHistory::MAX_VALUE / 4);
+    }
+
+    // Les scores de mat sont stockés relativement au noeud, pas à la racine
+    int scoreToTable(int score, int ply) {
+        if (score >= MATE_BOUND) return score + ply;
+        if (score <= -MATE_BOUND) return score - ply;
+        return score;
+    }
+
+    int scoreFromTable(int score, int ply) {
+        if (score >= MATE_BOUND) return score - ply;
+        if (score <= -MATE_BOUND) return score + ply;
+        return score;
+    }
+}
+
+std::string SearchLine::pvString() const {
+    return movesToString(pv);
+}
+
+std::string SearchResult::pvString() const {
+    return movesToString(pv);
+}
+
+std::string scoreToString(int score) {
+    if (score >= MATE_BOUND) return "mate " + std::to_string((MATE_SCORE - score + 1) / 2);
+    if (score <= -MATE_BOUND) return "mated " + std::to_string((MATE_SCORE + score) / 2);
+    int absolute = std::abs(score);
+    return (score < 0 ? "-" : "+") + std::to_string(absolute / 100) + "."
+         + std::to_string(absolute / 10 % 10) + std::to_string(absolute % 10);
+}
+
+SearchLimits SearchLimits::fromClock(double remainingSeconds, int maxDepth) {
+    SearchLimits limits;
+    limits.depth = maxDepth;
+
+    double available = std::max(0.0, remainingSeconds - CLOCK_SAFETY_MARGIN);
+    limits.softTime = std::max(MIN_THINK_TIME, available / MOVES_TO_GO);
+    limits.hardTime = std::max(MIN_THINK_TIME,
+                               std::min(limits.softTime * HARD_TO_SOFT_RATIO, available * MAX_CLOCK_FRACTION));
+    limits.softTime = std::min(limits.softTime, limits.hardTime);
+    return limits;
+}
+
+SearchResult Search::run(const Position& position, const SearchLimits& limits, const std::vector<uint64_t>& history) {
+    m_startTime = std::chrono::steady_clock::now();
+    m_clockStart = m_startTime;
+    m_pondering = limits.ponder && m_ponderSignal && m_ponderSignal->load();
+    m_position = position;
+    m_nodes = 0;
+    m_nodeLimit = limits.nodes;
+    m_hardTime = limits.hardTime;
+    m_rootMove = PackedMove();
+    m_stopped = false;
+    m_ttStats = TTStatistics();
+    m_keys[0] = m_position.key();
+    // Seules les positions depuis le dernier coup irréversible peuvent se répéter
+    size_t reversible = std::min<size_t>(history.size(), position.halfMoveClock());
+    m_gameKeys.assign(history.end() - reversible, history.end());
+    m_accumulators.reset();
+    m_history.age();
+    for (auto& killers : m_killers) killers[0] = killers[1] = PackedMove();
+
+    SearchResult result;
+    m_rootMoves.clear();
+    MoveGenerator(position).generateLegalMoves(position.sideToMove(), m_rootMoves);
+    if (m_rootMoves.empty()) return result;
+    m_rootPieceCount = popCount(position.pieces());
+    filterRootMoves();
+
+    int maxDepth = std::clamp(limits.depth, 1, MAX_PLY - 1);
+    int lineCount = std::clamp(limits.multiPV, 1, m_rootMoves.size());
+    double bestMoveChanges = 0.0;
+
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        if (skipsDepth(depth)) continue;
+        m_selDepth = 0;
+
+        // Une passe par variation, chacune sans les premiers coups des précédentes
+        std::vector<SearchLine> lines;
+        m_excludedRootMoves.clear();
+        for (int line = 0; line < lineCount; line++) {
+            // Essayé en premier: le meilleur coup restant de l'itération précédente
+            const SearchLine* previous = nullptr;
+            for (const SearchLine& candidate : result.lines) {
+                if (!m_excludedRootMoves.contains(candidate.pv[0])) {
+                    previous = &candidate;
+                    break;
+                }
+            }
+            m_rootMove = previous ? previous->pv[0] : PackedMove();
+
+            int score = depth >= ASPIRATION_MIN_DEPTH && m_options.aspirationWindows && previous
+                      ? aspirationSearch(depth, previous->score)
+                      : negamax(depth, 0, -INFINITE_SCORE, INFINITE_SCORE);
+
+            // Passe interrompue avant d'avoir fini un coup: on garde l'itération précédente.
+            // Sinon son meilleur coup a été entièrement recherché (le précédent passe en premier).
+            if (m_stopped && m_pvLength[0] == 0) break;
+
+            SearchLine found;
+            found.score = score;
+            found.pv.assign(m_pv[0], m_pv[0] + m_pvLength[0]);
+            lines.push_back(std::move(found));
+            m_excludedRootMoves.add(m_pv[0][0]);
+            if (m_stopped) break;
+        }
+        if (lines.empty()) break;
+
+        // Itération interrompue: profondeur, score et variations restent ceux de la précédente.
+        // Seul le meilleur coup de la première passe est repris s'il a changé: il a battu le
+        // coup précédent, recherché en premier, et sa variation l'accompagne.
+        if (m_stopped) {
+            const SearchLine& first = lines[0];
+            if (first.pv[0] != result.bestMove) {
+                result.bestMove = first.pv[0];
+                result.score = first.score;
+                result.pv = first.pv;
+                std::vector<SearchLine> kept(1, first);
+                for (const SearchLine& previous : result.lines) {
+                    if (static_cast<int>(kept.size()) >= lineCount) break;
+                    if (previous.pv[0] != first.pv[0]) kept.push_back(previous);
+                }
+                result.lines = std::move(kept);
+            }
+            break;
+        }
+
+        std::stable_sort(lines.begin(), lines.end(),
+                         [](const SearchLine& a, const SearchLine& b) { return a.score > b.score; });
+
+        PackedMove bestMove = lines[0].pv[0];
+        bestMoveChanges *= 0.5;
+        if (!result.bestMove.isNull() && bestMove != result.bestMove) bestMoveChanges += 1.0;
+
+        result.bestMove = bestMove;
+        result.score = lines[0].score;
+        result.depth = depth;
+        result.selDepth = m_selDepth;
+        result.pv = lines[0].pv;
+        result.lines = std::move(lines);
+
+        if (m_progressCallback) {
+            result.nodes = m_nodes;
+            result.seconds = elapsedSeconds();
+            m_progressCallback(result);
+        }
+
+        // Coup forcé, ou mat trouvé dans l'horizon: approfondir ne changera rien
+        // (sauf en analyse, ou en ponder tant que l'adversaire n'a pas joué)
+        checkPonderHit();
+        bool unbounded = limits.infinite || m_pondering;
+        if (!unbounded && m_rootMoves.size() == 1) break;
+        if (!unbounded && std::abs(result.score) >= MATE_BOUND && MATE_SCORE - std::abs(result.score) <= depth) {
+            break;
+        }
+
+        // Limite souple, allongée tant que le meilleur coup est instable.
+        // Seul le thread principal décide: les auxiliaires s'arrêtent sur le signal partagé.
+        if (m_threadIndex == 0 && limits.softTime > 0.0 && !m_pondering) {
+            double softTime = limits.softTime * (1.0 + bestMoveChanges);
+            if (limits.hardTime > 0.0) softTime = std::min(softTime, limits.hardTime);
+            if (clockSeconds() >= softTime) break;
+        }
+    }
+
+    // Interrompue avant la fin de la première itération: meilleur coup selon l'ordre de tri
+    if (result.bestMove.isNull()) {
+        PackedMove ordered = MovePicker(position, PackedMove(), m_history).next();
+        result.bestMove = m_rootMoves.contains(ordered) ? ordered : m_rootMoves[0];
+        result.pv.assign(1, result.bestMove);
+        result.score = m_network ? m_network->evaluate(position) : Evaluator::evaluate(position);
+        result.lines.assign(1, SearchLine{ result.score, result.pv });
+    }
+
+    result.nodes = m_nodes;
+    result.tt = m_ttStats;
+    result.hashfull = m_table ? m_table->hashfull() : 0;
+    result.aborted = m_stopped;
+    result.seconds = elapsedSeconds();
+    return result;
+}
+
+void Search::setOptions(const SearchOptions& options) {
+    m_options = options;
+
+    // Réduction en fonction de la profondeur et du rang du coup: base + ln(d)·ln(n) / diviseur
+    for (int depth = 1; depth < MAX_REDUCTION_INDEX; depth++) {
+        for (int moveCount = 1; moveCount < MAX_REDUCTION_INDEX; moveCount++) {
+            double reduction = options.lmrBase + std::log(depth) * std::log(moveCount) / options.lmrDivisor;
+            m_reductions[depth][moveCount] = std::max(0, static_cast<int>(reduction));
+        }
+    }
+}
+
+void Search::filterRootMoves() {
+    Wdl rootResult;
+    if (!m_bitbases || !m_bitbases->probe(m_position, rootResult)) return;
+
+    MoveList kept;
+    for (int i = 0; i < m_rootMoves.size(); i++) {
+        StateInfo state;
+        Wdl childResult;
+        m_position.makeMove(m_rootMoves[i], state);
+        bool known = m_bitbases->probe(m_position, childResult);
+        m_position.unmakeMove(m_rootMoves[i], state);
+        // Résultat inconnu (prise en passant possible): coup conservé
+        if (!known || static_cast<int>(childResult) == -static_cast<int>(rootResult)) kept.add(m_rootMoves[i]);
+    }
+    if (!kept.empty()) m_rootMoves = kept;
+}
+
+bool Search::probeBitbases(int ply, int& score) {
+    // Seulement après une prise depuis la racine: sinon la recherche normale trouve le chemin
+    int pieceCount = popCount(m_position.pieces());
+    if (!m_bitbases || pieceCount > EndgameBitbases::MAX_PIECES || pieceCount >= m_rootPieceCount) return false;
+
+    Wdl result;
+    if (!m_bitbases->probe(m_position, result)) return false;
+    score = result == Wdl::Win ? BITBASE_WIN_SCORE - ply : result == Wdl::Loss ? -BITBASE_WIN_SCORE + ply : 0;
+    return true;
+}
+
+void Search::setNetwork(const Nnue::Network* network) {
+    m_network = network && network->isLoaded() ? network : nullptr;
+    m_accumulators.setNetwork(m_network);
+}
+
+int Search::aspirationSearch(int depth, int previousScore) {
+    // Fenêtre étroite autour du score précédent, élargie à chaque échec
+    if (std::abs(previousScore) >= MATE_BOUND) return negamax(depth, 0, -INFINITE_SCORE, INFINITE_SCORE);
+
+    int delta = ASPIRATION_DELTA;
+    int alpha = std::max(previousScore - delta, -INFINITE_SCORE);
+    int beta = std::min(previousScore + delta, INFINITE_SCORE);
+
+    while (true) {
+        int score = negamax(depth, 0, alpha, beta);
+        if (m_stopped) return score;
+
+        if (score <= alpha) {
+            beta = (alpha + beta) / 2;
+            alpha = std::max(score - delta, -INFINITE_SCORE);
+        } else if (score >= beta) {
+            beta = std::min(score + delta, INFINITE_SCORE);
+        } else {
+            return score;
+        }
+        delta *= 2;
+        if (delta > 1000) {
+            alpha = -INFINITE_SCORE;
+            beta = INFINITE_SCORE;
+        }
+    }
+}
+
+int Search::negamax(int depth, int ply, int alpha, int beta) {
+    // Horizon: on ne s'arrête que sur une position calme
+    if (depth <= 0) return quiescence(ply, alpha, beta);
+
+    m_pvLength[ply] = ply;
+    m_nodes++;
+    m_selDepth = std::max(m_selDepth, ply + 1);
+    checkLimits();
+    if (m_stopped) return 0;
+
+    if (ply > 0 && isDraw(ply)) return 0;
+
+    int bitbaseScore;
+    if (ply > 0 && probeBitbases(ply, bitbaseScore)) return bitbaseScore;
+
+    // Table de transposition: coupure si l'entrée est assez profonde et concluante
+    TTEntry entry;
+    PackedMove hashMove = ply == 0 ? m_rootMove : PackedMove();
+    if (m_table && m_table->probe(m_position.key(), entry, m_ttStats)) {
+        if (hashMove.isNull()) hashMove = entry.move;
+        if (ply > 0 && entry.depth >= depth) {
+            int ttScore = scoreFromTable(entry.score, ply);
+            if (entry.bound == Bound::Exact
+                || (entry.bound == Bound::Lower && ttScore >= beta)
+                || (entry.bound == Bound::Upper && ttScore <= alpha)) {
+                return ttScore;
+            }
+        }
+    }
+
+    Color us = m_position.sideToMove();
+    bool inCheck = m_position.isInCheck(us);
+    if (ply >= MAX_PLY - 1) {
+        return inCheck ? 0 : evaluate();
+    }
+
+    // Élagage hors variation principale et hors échec, à partir de l'évaluation statique
+    bool pvNode = beta - alpha > 1;
+    int staticEval = inCheck ? -INFINITE_SCORE : evaluate();
+    if (!pvNode && !inCheck && ply > 0) {
+        // Reverse futility: même en concédant une marge par demi-coup, on reste au-dessus de bêta
+        if (m_options.reverseFutility && depth <= REVERSE_FUTILITY_DEPTH && std::abs(beta) < MATE_BOUND
+            && staticEval - REVERSE_FUTILITY_MARGIN * depth >= beta) {
+            return staticEval;
+        }
+
+        // Coup nul: si passer son tour suffit encore à dépasser bêta, le noeud est coupé.
+        // Zugzwang: jamais sans pièce autre que pions et roi, ni deux coups nuls de suite,
+        // et vérification par une recherche réduite aux grandes profondeurs.
+        Bitboard nonPawnMaterial = m_position.pieces(us)
+            & ~(m_position.pieces(PieceType::Pawn) | m_position.pieces(PieceType::King));
+        if (m_options.nullMove && m_nullMoveAllowed && depth >= NULL_MOVE_MIN_DEPTH && staticEval >= beta
+            && nonPawnMaterial && !m_moves[ply - 1].isNull()) {
+            int reduction = 3 + depth / 6;
+            doNullMove(ply);
+            int score = -negamax(depth - 1 - reduction, ply + 1, -beta, -beta + 1);
+            undoNullMove(ply);
+            if (m_stopped) return 0;
+
+            if (score >= beta) {
+                if (score >= MATE_BOUND) score = beta;  // Mat non prouvé: le coup nul n'est pas légal
+                if (depth < NULL_MOVE_VERIFY_DEPTH) return score;
+
+                m_nullMoveAllowed = false;
+                int verified = negamax(depth - 1 - reduction, ply, beta - 1, beta);
+                m_nullMoveAllowed = true;
+                if (verified >= beta) return score;
+            }
+        }
+    }
+
+    // Réfutation du coup précédent, indexée par la pièce qui l'a joué et sa case d'arrivée
+    PackedMove counterMove;
+    if (ply > 0 && !m_moves[ply - 1].isNull()) {
+        int previousTo = m_moves[ply - 1].to();
+        counterMove = m_counterMoves[m_position.pieceOn(previousTo)][previousTo];
+    }
+
+    MovePicker picker(m_position, hashMove, m_history, m_killers[ply], counterMove);
+    MoveGenerator generator(m_position);
+    PackedMove quietsTried[MAX_QUIETS_TRIED];
+    int quietCount = 0;
+
+    int originalAlpha = alpha;
+    PackedMove bestMove;
+    int bestScore = -INFINITE_SCORE;
+    int moveCount = 0;
+    bool futile = m_options.futility && !pvNode && !inCheck && depth <= FUTILITY_DEPTH
+               && staticEval + FUTILITY_MARGINS[std::max(depth, 0)] <= alpha;
+    for (PackedMove move = picker.next(); !move.isNull(); move = picker.next()) {
+        if (ply == 0 && (!m_rootMoves.contains(move) || m_excludedRootMoves.contains(move))) continue;
+        bool quiet = !generator.isTactical(move);
+        moveCount++;
+
+        doMove(ply, move);
+        bool givesCheck = m_position.isInCheck(m_position.sideToMove());
+
+        // Futility: près de l'horizon, un coup calme ne rattrapera pas l'écart avec alpha
+        if (futile && quiet && !givesCheck && moveCount > 1) {
+            undoMove(ply, move);
+            continue;
+        }
+
+        int newDepth = depth - 1;
+        int score;
+        if (moveCount == 1) {
+            score = -negamax(newDepth, ply + 1, -beta, -alpha);
+        } else {
+            // Réduction des coups calmes tardifs, annulée si le coup dépasse alpha
+            int reduction = 0;
+            if (m_options.lateMoveReductions && depth >= LMR_MIN_DEPTH && quiet && !inCheck && !givesCheck) {
+                reduction = m_reductions[std::min(depth, MAX_REDUCTION_INDEX - 1)]
+                                        [std::min(moveCount, MAX_REDUCTION_INDEX - 1)];
+                if (pvNode) reduction--;
+                reduction = std::clamp(reduction, 0, newDepth - 1);
+            }
+
+            // PVS: les coups suivants sont d'abord réfutés avec une fenêtre nulle
+            int scoutBeta = m_options.principalVariation ? alpha + 1 : beta;
+            score = -negamax(newDepth - reduction, ply + 1, -scoutBeta, -alpha);
+            if (reduction > 0 && score > alpha) {
+                score = -negamax(newDepth, ply + 1, -scoutBeta, -alpha);
+            }
+            if (scoutBeta < beta && score > alpha && score < beta) {
+                score = -negamax(newDepth, ply + 1, -beta, -alpha);
+            }
+        }
+        undoMove(ply, move);
+
+        // Score d'un sous-arbre interrompu: inutilisable
+        if (m_stopped) break;
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+            if (score > alpha) {
+                alpha = score;
+
+                // Nouvelle variation principale: ce coup suivi de celle du fils
+                m_pv[ply][ply] = move;
+                for (int i = ply + 1; i < m_pvLength[ply + 1]; i++) {
+                    m_pv[ply][i] = m_pv[ply + 1][i];
+                }
+                m_pvLength[ply] = m_pvLength[ply + 1];
+
+                if (alpha >= beta) {
+                    if (quiet) updateQuietStats(ply, depth, move, quietsTried, quietCount);
+                    break;
+                }
+            }
+        }
+
+        if (quiet && quietCount < MAX_QUIETS_TRIED) quietsTried[quietCount++] = move;
+    }
+
+    // Mat ou pat (des coups élagués par futility existent: moveCount les compte)
+    if (moveCount == 0) {
+        return inCheck ? -MATE_SCORE + ply : 0;
+    }
+
+    if (m_stopped) return bestScore == -INFINITE_SCORE ? alpha : bestScore;
+
+    // Passe MultiPV sans les meilleurs coups: son score ne vaut pas pour la position
+    if (m_table && !(ply == 0 && !m_excludedRootMoves.empty())) {
+        Bound bound = bestScore >= beta ? Bound::Lower
+                    : bestScore > originalAlpha ? Bound::Exact : Bound::Upper;
+        m_table->store(m_position.key(), bound == Bound::Upper ? PackedMove() : bestMove,
+                       scoreToTable(bestScore, ply), depth, bound, m_ttStats);
+    }
+    return bestScore;
+}
+
+int Search::quiescence(int ply, int alpha, int beta) {
+    m_pvLength[ply] = ply;
+    m_nodes++;
+    m_selDepth = std::max(m_selDepth, ply + 1);
+    checkLimits();
+    if (m_stopped) return 0;
+
+    if (isDraw(ply)) return 0;
+
+    int bitbaseScore;
+    if (probeBitbases(ply, bitbaseScore)) return bitbaseScore;
+
+    Color us = m_position.sideToMove();
+    bool inCheck = m_position.isInCheck(us);
+    if (ply >= MAX_PLY - 1) {
+        return inCheck ? 0 : evaluate();
+    }
+
+    // En échec, pas de « stand pat »: toutes les parades sont examinées. Sinon le camp
+    // au trait peut refuser toutes les prises: l'évaluation statique est un minimum.
+    int bestScore = -INFINITE_SCORE;
+    if (!inCheck) {
+        bestScore = evaluate();
+        if (bestScore >= beta) return bestScore;
+        alpha = std::max(alpha, bestScore);
+    }
+
+    // Prises et promotions, sauf celles qui perdent du matériel selon l'échange statique
+    MovePicker picker(m_position, m_history);
+    int moveCount = 0;
+    for (PackedMove move = picker.next(); !move.isNull(); move = picker.next()) {
+        moveCount++;
+        doMove(ply, move);
+        int score = -quiescence(ply + 1, -beta, -alpha);
+        undoMove(ply, move);
+
+        if (m_stopped) break;
+
+        if (score > bestScore) {
+            bestScore = score;
+            if (score > alpha) {
+                alpha = score;
+
+                m_pv[ply][ply] = move;
+                for (int i = ply + 1; i < m_pvLength[ply + 1]; i++) {
+                    m_pv[ply][i] = m_pv[ply + 1][i];
+                }
+                m_pvLength[ply] = m_pvLength[ply + 1];
+
+                if (alpha >= beta) break;
+            }
+        }
+    }
+
+    if (inCheck && moveCount == 0) return -MATE_SCORE + ply;
+    if (m_stopped && bestScore == -INFINITE_SCORE) return alpha;
+    return bestScore;
+}
+
+int Search::evaluate() {
+    return m_network ? m_accumulators.evaluate(m_position) : Evaluator::evaluate(m_position, &m_pawnTable);
+}
+
+void Search::doMove(int ply, PackedMove move) {
+    m_moves[ply] = move;
+    m_position.makeMove(move, m_states[ply]);
+    m_keys[ply + 1] = m_position.key();
+    if (m_network) m_accumulators.push(m_states[ply]);
+}
+
+void Search::undoMove(int ply, PackedMove move) {
+    if (m_network) m_accumulators.pop();
+    m_position.unmakeMove(move, m_states[ply]);
+}
+
+void Search::doNullMove(int ply) {
+    m_moves[ply] = PackedMove();
+    m_position.makeNullMove(m_states[ply]);
+    m_keys[ply + 1] = m_position.key();
+    if (m_network) m_accumulators.push(m_states[ply]);
+}
+
+void Search::undoNullMove(int ply) {
+    if (m_network) m_accumulators.pop();
+    m_position.unmakeNullMove(m_states[ply]);
+}
+
+void Search::updateQuietStats(int ply, int depth, PackedMove move, const PackedMove* quietsTried,
+                              int quietCount) {
+    if (m_killers[ply][0] != move) {
+        m_killers[ply][1] = m_killers[ply][0];
+        m_killers[ply][0] = move;
+    }
+
+    if (ply > 0 && !m_moves[ply - 1].isNull()) {
+        int previousTo = m_moves[ply - 1].to();
+        m_counterMoves[m_position.pieceOn(previousTo)][previousTo] = move;
+    }
+
+    Color us = m_position.sideToMove();
+    int bonus = historyBonus(depth);
+    m_history.update(us, move, bonus);
+    for (int i = 0; i < quietCount; i++) {
+        m_history.update(us, quietsTried[i], -bonus);
+    }
+}
+
+void Search::checkLimits() {
+    if (m_stopSignal && m_stopSignal->load(std::memory_order_relaxed)) m_stopped = true;
+    if (m_nodeLimit && m_nodes >= m_nodeLimit) m_stopped = true;
+    if (m_pondering) checkPonderHit();
+    if (m_hardTime > 0.0 && !m_pondering && m_nodes % TIME_CHECK_INTERVAL == 0 && clockSeconds() >= m_hardTime) {
+        m_stopped = true;
+    }
+}
+
+void Search::checkPonderHit() {
+    // Coup attendu joué: la recherche continue, la pendule démarre maintenant
+    if (m_pondering && !m_ponderSignal->load(std::memory_order_relaxed)) {
+        m_pondering = false;
+        m_clockStart = std::chrono::steady_clock::now();
+    }
+}
+
+bool Search::skipsDepth(int depth) const {
+    if (m_threadIndex == 0 || depth == 1) return false;
+    int pattern = (m_threadIndex - 1) % SKIP_PATTERNS;
+    return ((depth + SKIP_PHASE[pattern]) / SKIP_SIZE[pattern]) % 2 == 1;
+}
+
+double Search::elapsedSeconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+}
+
+double Search::clockSeconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_clockStart).count();
+}
+
+bool Search::isDraw(int ply) const {
+    if (m_position.halfMoveClock() >= 100) return true;
+
+    // Répétition le long de la variation, puis dans la partie avant la racine (indices
+    // négatifs), sans traverser un coup irréversible
+    int gameCount = static_cast<int>(m_gameKeys.size());
+    int oldest = std::max(-gameCount, ply - m_position.halfMoveClock());
+    for (int i = ply - 4; i >= oldest; i -= 2) {
+        uint64_t key = i >= 0 ? m_keys[i] : m_gameKeys[gameCount + i];
+        if (key == m_keys[ply]) return true;
+    }
+
+    // Matériel insuffisant: rois seuls, ou roi et une pièce mineure
+    Bitboard heavy = m_position.pieces(PieceType::Pawn) | m_position.pieces(PieceType::Rook)
+                   | m_position.pieces(PieceType::Queen);
+    if (!heavy) {
+        Bitboard minors = m_position.pieces(PieceType::Knight) | m_position.pieces(PieceType::Bishop);
+        if (!moreThanOne(minors)) return true;
+    }
+    return false;
+}
@@ -0,0 +1,137 @@
+#include "TranspositionTable.h"
+#include <iostream>
+
+namespace {
+    // Disposition du mot data: coup (16) | score (16) | profondeur (8) | bound (2) | génération (6)
+    constexpr int SCORE_SHIFT = 16;
+    constexpr int DEPTH_SHIFT = 32;
+    constexpr int BOUND_SHIFT = 40;
+    constexpr int GENERATION_SHIFT = 42;
+
+    uint64_t packData(PackedMove move, int score, int depth, Bound bound, uint8_t generation) {
+        return static_cast<uint64_t>(move.raw())
+             | static_cast<uint64_t>(static_cast<uint16_t>(static_cast<int16_t>(score))) << SCORE_SHIFT
+             | static_cast<uint64_t>(static_cast<uint8_t>(depth)) << DEPTH_SHIFT
+             | static_cast<uint64_t>(bound) << BOUND_SHIFT
+             | static_cast<uint64_t>(generation) << GENERATION_SHIFT;
+    }
+
+    Bound boundOf(uint64_t data) { return static_cast<Bound>((data >> BOUND_SHIFT) & 3); }
+    int depthOf(uint64_t data) { return static_cast<uint8_t>(data >> DEPTH_SHIFT); }
+    uint8_t generationOf(uint64_t data) { return static_cast<uint8_t>(data >> GENERATION_SHIFT); }
+}
+
+TTStatistics& TTStatistics::operator+=(const TTStatistics& other) {
+    probes += other.probes;
+    hits += other.hits;
+    stores += other.stores;
+    collisions += other.collisions;
+    return *this;
+}
+
+TranspositionTable::TranspositionTable(size_t megabytes) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    // Plus grande puissance de deux de buckets qui tient dans la taille demandée
+    size_t requested = (megabytes ? megabytes : 1) * 1024 * 1024 / sizeof(Bucket);
+    size_t count = 1;
+    while (count * 2 <= requested) count *= 2;
+
+    if (count != m_bucketCount) {
+        m_buckets = std::make_unique<Bucket[]>(count);
+        m_bucketCount = count;
+    } else {
+        clear();
+    }
+    m_generation = 0;
+
+    std::cout << "[TranspositionTable] " << sizeMB() << " MB, " << m_bucketCount * ENTRIES_PER_BUCKET
+              << " entries" << std::endl;
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < m_bucketCount; i++) {
+        for (Slot& slot : m_buckets[i].slots) {
+            slot.keyXorData.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& entry, TTStatistics& stats) const {
+    stats.probes++;
+    const Bucket& bucket = bucketFor(key);
+
+    for (const Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if ((slot.keyXorData.load(std::memory_order_relaxed) ^ data) != key) continue;
+        if (boundOf(data) == Bound::None) continue;
+
+        entry.move = PackedMove(static_cast<uint16_t>(data));
+        entry.score = static_cast<int16_t>(data >> SCORE_SHIFT);
+        entry.depth = static_cast<uint8_t>(depthOf(data));
+        entry.bound = boundOf(data);
+        stats.hits++;
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, PackedMove move, int score, int depth, Bound bound,
+                               TTStatistics& stats) {
+    Bucket& bucket = bucketFor(key);
+    Slot* target = nullptr;
+    int lowestWorth = 0;
+
+    for (Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t slotKey = slot.keyXorData.load(std::memory_order_relaxed) ^ data;
+
+        // Même position, ou entrée vide: on la prend directement
+        if (slotKey == key || boundOf(data) == Bound::None) {
+            if (slotKey == key) {
+                // Une entrée nettement plus profonde de cette recherche reste plus utile
+                if (bound != Bound::Exact && generationOf(data) == m_generation && depth + 2 < depthOf(data)) {
+                    return;
+                }
+                // Garder le coup connu si la nouvelle recherche n'en a pas trouvé
+                if (move.isNull()) move = PackedMove(static_cast<uint16_t>(data));
+            }
+            target = &slot;
+            break;
+        }
+
+        // Sinon la moins utile: faible profondeur, vieilles générations pénalisées
+        int age = (m_generation - generationOf(data)) & GENERATION_MASK;
+        int worth = depthOf(data) - 8 * age;
+        if (!target || worth < lowestWorth) {
+            target = &slot;
+            lowestWorth = worth;
+        }
+    }
+
+    uint64_t previous = target->data.load(std::memory_order_relaxed);
+    uint64_t previousKey = target->keyXorData.load(std::memory_order_relaxed) ^ previous;
+    if (previousKey != key && boundOf(previous) != Bound::None && generationOf(previous) == m_generation) {
+        stats.collisions++;
+    }
+
+    uint64_t data = packData(move, score, depth, bound, m_generation);
+    target->keyXorData.store(key ^ data, std::memory_order_relaxed);
+    target->data.store(data, std::memory_order_relaxed);
+    stats.stores++;
+}
+
+int TranspositionTable::hashfull() const {
+    size_t sample = m_bucketCount < 250 ? m_bucketCount : 250;
+    int used = 0;
+    for (size_t i = 0; i < sample; i++) {
+        for (const Slot& slot : m_buckets[i].slots) {
+            uint64_t data = slot.data.load(std::memory_order_relaxed);
+            if (boundOf(data) != Bound::None && generationOf(data) == m_generation) used++;
+        }
+    }
+    return sample ? static_cast<int>(used * 1000 / (sample * ENTRIES_PER_BUCKET)) : 0;
+}
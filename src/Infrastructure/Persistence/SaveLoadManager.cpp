@@ -1,36 +1,24 @@
 #include "Services/SaveLoadManager.h"
 #include "ChessBoard.h"
-#include "Entities/ChessPiece.h"
+#include "Entities/Position.h"
 #include "Color.h"
+#include "PieceType.h"
 #include "Services/Logger.h"
+#include <cctype>
+#include <cstring>
 #include <fstream>
-#include <unordered_map>
 
 // Simple custom format:
 // 8x8 tokens row-major. Each cell is two chars: color + type (e.g., wP, bK), or ".." for empty.
 // Color: 'w' = white, 'b' = black
 // Type char mapping: P=Pawn, R=Rook, N=Knight, B=Bishop, Q=Queen, K=King
 
-static char typeStringToChar(const std::string& type) {
-    if (type == "pawn") return 'P';
-    if (type == "rook") return 'R';
-    if (type == "knight") return 'N';
-    if (type == "bishop") return 'B';
-    if (type == "queen") return 'Q';
-    if (type == "king") return 'K';
-    return '?';
-}
+// Type char for each PieceType, in enum order (Pawn..King)
+static const char TYPE_CHARS[] = "PNBRQK";
 
-static std::string typeCharToString(char c) {
-    switch (c) {
-    case 'P': case 'p': return "pawn";
-    case 'R': case 'r': return "rook";
-    case 'N': case 'n': return "knight";
-    case 'B': case 'b': return "bishop";
-    case 'Q': case 'q': return "queen";
-    case 'K': case 'k': return "king";
-    default: return "";
-    }
+static PieceType typeFromChar(char c) {
+    const char* found = c ? std::strchr(TYPE_CHARS, std::toupper(static_cast<unsigned char>(c))) : nullptr;
+    return found ? static_cast<PieceType>(found - TYPE_CHARS) : PieceType::None;
 }
 
 bool SaveLoadManager::saveToFile(const std::string& filePath, const ChessBoard& board) {
@@ -42,11 +30,9 @@ bool SaveLoadManager::saveToFile(const std::string& filePath, const ChessBoard&
 
     for (int r = 0; r < 8; ++r) {
         for (int c = 0; c < 8; ++c) {
-            const ChessPiece* p = board.getPieceAt(r, c);
-            if (p && !p->type.empty()) {
-                char colorChar = (p->color == "white") ? 'w' : 'b';
-                char typeChar = typeStringToChar(p->type);
-                out << colorChar << typeChar;
+            Piece piece = board.getPosition().pieceOn(squareAt(r, c));
+            if (piece != NO_PIECE) {
+                out << (colorOf(piece) == Color::White ? 'w' : 'b') << TYPE_CHARS[toIndex(typeOf(piece))];
             } else {
                 out << "..";
             }
@@ -88,21 +74,21 @@ bool SaveLoadManager::loadFromFile(const std::string& filePath, ChessBoard& boar
                 char colorChar = token[0];
                 char typeChar = token[1];
 
-                std::string color;
-                if (colorChar == 'w') color = "white";
-                else if (colorChar == 'b') color = "black";
+                Color color;
+                if (colorChar == 'w') color = Color::White;
+                else if (colorChar == 'b') color = Color::Black;
                 else {
                     Logger::getInstance().logError("Invalid color in token: " + token);
                     return false;
                 }
 
-                std::string type = typeCharToString(typeChar);
-                if (type.empty()) {
+                PieceType type = typeFromChar(typeChar);
+                if (type == PieceType::None) {
                     Logger::getInstance().logError("Invalid piece type in token: " + token);
                     return false;
                 }
 
-                board.setPieceByNames(r, c, type, color);
+                board.setPiece(r, c, type, color);
             } else {
                 Logger::getInstance().logError("Invalid token size: " + token);
                 return false;